@@ -0,0 +1,78 @@
+#pragma once
+#include "../tests/synthetic_data.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+
+namespace openrisk::bench {
+
+/**
+ * @brief 基准测试用合成数据
+ * 与单元测试共用 tests/synthetic_data.hpp 中的生成器，float 基准可以据此报告
+ * 相对 double 结果的误差 (rel_err 计数器)。
+ */
+using synthetic::garch_returns;
+using synthetic::lppl_series;
+using synthetic::LPPLSeries;
+using synthetic::return_panel;
+
+/**
+ * @brief T x N 面板，每列为独立种子的 GARCH(1,1) 序列
+ */
+template <core::FloatingPoint T>
+Eigen::MatrixX<T> garch_panel(std::size_t t, std::size_t n, uint32_t seed = 42) {
+    Eigen::MatrixX<T> panel(t, n);
+    for (std::size_t j = 0; j < n; ++j) {
+        panel.col(j) = garch_returns<T>(t, seed + static_cast<uint32_t>(j));
+    }
+    return panel;
+}
+
+/**
+ * @brief 正定相关矩阵 (等相关 rho) 的 Cholesky 因子
+ */
+template <core::FloatingPoint T>
+Eigen::MatrixX<T> equicorrelation_cholesky(std::size_t dims, double rho = 0.3) {
+    Eigen::MatrixXd corr = Eigen::MatrixXd::Constant(dims, dims, rho);
+    corr.diagonal().setOnes();
+    Eigen::MatrixXd l = corr.llt().matrixL();
+    return l.cast<T>();
+}
+
+/**
+ * @brief 优化器对比基准的参数：第二个参数为 core::OptimizerKind
+ */
+inline void optimizer_kinds(benchmark::internal::Benchmark* b, std::initializer_list<int64_t> sizes) {
+    for (int64_t n : sizes) {
+        for (auto kind : {core::OptimizerKind::LBFGS, core::OptimizerKind::NelderMead,
+                          core::OptimizerKind::DifferentialEvolution}) {
+            b->Args({n, static_cast<int64_t>(kind)});
+        }
+    }
+    b->ArgNames({"n", "optimizer"});
+}
+
+inline double relative_error(double value, double reference) {
+    return std::abs(value - reference) / std::max(std::abs(reference), 1e-300);
+}
+
+/**
+ * @brief float 基准报告相对 double 参考值的误差，double 基准不设置该计数器
+ */
+template <core::FloatingPoint T>
+void report_accuracy(benchmark::State& state, double value, double reference) {
+    if constexpr (!std::is_same_v<T, double>) {
+        state.counters["rel_err"] = relative_error(value, reference);
+    }
+}
+
+/**
+ * @brief 矩阵结果的相对误差 ||value - reference||_F / ||reference||_F
+ */
+template <core::FloatingPoint T>
+void report_accuracy(benchmark::State& state, const Eigen::MatrixX<T>& value, const Eigen::MatrixXd& reference) {
+    if constexpr (!std::is_same_v<T, double>) {
+        state.counters["rel_err"] = (value.template cast<double>() - reference).norm() / reference.norm();
+    }
+}
+
+} // namespace openrisk::bench
@@ -0,0 +1,60 @@
+#include "bench_common.hpp"
+#include "openrisk/core/lbfgs.hpp"
+#include "openrisk/core/stats.hpp"
+
+namespace openrisk::bench {
+
+/**
+ * @brief 至多 50 次迭代的 L-BFGS (扩展 Rosenbrock 函数)，items/s 即每秒实际完成的迭代数
+ * 关闭梯度与函数值收敛判据；线搜索失败仍可能提前结束，因此按 result.iterations 计数
+ */
+template <core::FloatingPoint T>
+void BM_LBFGSIteration(benchmark::State& state) {
+    const Eigen::Index dims = state.range(0);
+    typename core::LBFGSOptimizer<T>::Config config;
+    config.max_iter = 50;
+    config.g_tol = 0;
+    config.f_tol = 0;
+    core::LBFGSOptimizer<T> opt(config);
+
+    auto rosenbrock = [](const Eigen::VectorX<T>& x) -> T {
+        T sum = 0;
+        for (Eigen::Index i = 0; i + 1 < x.size(); ++i) {
+            const T a = x(i + 1) - x(i) * x(i);
+            const T b = 1 - x(i);
+            sum += 100 * a * a + b * b;
+        }
+        return sum;
+    };
+    const Eigen::VectorX<T> x0 = Eigen::VectorX<T>::Constant(dims, T(-1.2));
+    const Eigen::VectorX<T> none;
+
+    int64_t iterations = 0;
+    for (auto _ : state) {
+        auto result = opt.minimize(rosenbrock, x0, none, none);
+        benchmark::DoNotOptimize(result.min_value);
+        iterations += result.iterations;
+    }
+    state.SetItemsProcessed(iterations);
+}
+
+template <core::FloatingPoint T>
+void BM_Moments(benchmark::State& state) {
+    const auto returns = garch_returns<T>(state.range(0));
+    T value = 0;
+
+    for (auto _ : state) {
+        value = core::Statistics<T>::kurtosis(returns);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    report_accuracy<T>(state, value, core::Statistics<double>::kurtosis(garch_returns<double>(state.range(0))));
+}
+
+BENCHMARK_TEMPLATE(BM_LBFGSIteration, double)->RangeMultiplier(4)->Range(2, 128);
+BENCHMARK_TEMPLATE(BM_LBFGSIteration, float)->RangeMultiplier(4)->Range(2, 128);
+BENCHMARK_TEMPLATE(BM_Moments, double)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+BENCHMARK_TEMPLATE(BM_Moments, float)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+
+} // namespace openrisk::bench
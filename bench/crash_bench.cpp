@@ -0,0 +1,67 @@
+#include "bench_common.hpp"
+#include "openrisk/crash/lppl.hpp"
+
+namespace openrisk::bench {
+
+template <core::FloatingPoint T>
+void BM_LPPLCost(benchmark::State& state) {
+    const auto series = lppl_series<T>(state.range(0));
+    const crash::LPPLParams<T> params{T(8.0), T(-0.5), T(0.02), series.t_last + T(20), T(0.4), T(9.0), T(1.0)};
+    T value = 0;
+
+    for (auto _ : state) {
+        value = crash::LPPLModel<T>::cost_function(series.t, series.log_p, params);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    const auto ref_series = lppl_series<double>(state.range(0));
+    const crash::LPPLParams<double> ref_params{8.0, -0.5, 0.02, ref_series.t_last + 20.0, 0.4, 9.0, 1.0};
+    report_accuracy<T>(state, value, crash::LPPLModel<double>::cost_function(ref_series.t, ref_series.log_p, ref_params));
+}
+
+template <core::FloatingPoint T>
+void BM_LPPLCalibrate(benchmark::State& state) {
+    const auto series = lppl_series<T>(state.range(0));
+    crash::LPPLParams<T> params{};
+
+    for (auto _ : state) {
+        params = crash::LPPLCalibrator<T>::calibrate(series.t, series.log_p, series.t_last);
+        benchmark::DoNotOptimize(params);
+    }
+
+    const auto ref_series = lppl_series<double>(state.range(0));
+    const auto ref = crash::LPPLCalibrator<double>::calibrate(ref_series.t, ref_series.log_p, ref_series.t_last);
+    report_accuracy<T>(state, params.tc, ref.tc);
+}
+
+/**
+ * @brief 各优化引擎的标定耗时与所得残差平方和 (sse) 及 tc 误差
+ */
+void BM_LPPLCalibrateOptimizer(benchmark::State& state) {
+    const auto series = lppl_series<double>(state.range(0));
+    crash::LPPLCalibrationConfig<double> config;
+    config.optimizer = static_cast<core::OptimizerKind>(state.range(1));
+    core::OptimizationStats<double> stats;
+    config.stats = &stats;
+    crash::LPPLParams<double> params{};
+
+    for (auto _ : state) {
+        params = crash::LPPLCalibrator<double>::calibrate(series.t, series.log_p, series.t_last, config);
+        benchmark::DoNotOptimize(params);
+    }
+
+    state.counters["sse"] = crash::LPPLModel<double>::cost_function(series.t, series.log_p, params);
+    state.counters["tc_err"] = std::abs(params.tc - (series.t_last + 21.0));
+    state.counters["evals"] = static_cast<double>(stats.objective_evaluations);
+}
+
+BENCHMARK_TEMPLATE(BM_LPPLCost, double)->RangeMultiplier(10)->Range(100, 1'000'000);
+BENCHMARK_TEMPLATE(BM_LPPLCost, float)->RangeMultiplier(10)->Range(100, 1'000'000);
+BENCHMARK_TEMPLATE(BM_LPPLCalibrate, double)->RangeMultiplier(4)->Range(250, 16'000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_LPPLCalibrate, float)->RangeMultiplier(4)->Range(250, 16'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LPPLCalibrateOptimizer)
+    ->Apply([](benchmark::internal::Benchmark* b) { optimizer_kinds(b, {500, 4'000}); })
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace openrisk::bench
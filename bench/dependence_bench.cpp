@@ -0,0 +1,72 @@
+#include "bench_common.hpp"
+#include "openrisk/dependence/copula.hpp"
+#include "openrisk/dependence/correlation.hpp"
+
+namespace openrisk::bench {
+
+template <core::FloatingPoint T>
+void BM_GaussianCopula(benchmark::State& state) {
+    const auto l = equicorrelation_cholesky<T>(state.range(0));
+    Eigen::MatrixX<T> samples(state.range(1), state.range(0));
+
+    for (auto _ : state) {
+        dependence::Copula<T>::generate_gaussian_samples(l, samples);
+        benchmark::DoNotOptimize(samples.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+
+template <core::FloatingPoint T>
+void BM_StudentTCopula(benchmark::State& state) {
+    const auto l = equicorrelation_cholesky<T>(state.range(0));
+    Eigen::MatrixX<T> samples(state.range(1), state.range(0));
+
+    for (auto _ : state) {
+        dependence::Copula<T>::generate_t_samples(l, T(5), samples);
+        benchmark::DoNotOptimize(samples.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+
+enum class CorrelationKind { Pearson, Spearman, Kendall };
+
+template <core::FloatingPoint T, CorrelationKind Kind>
+void BM_Correlation(benchmark::State& state) {
+    const auto panel = return_panel<T>(state.range(0), 2);
+    auto compute = [](const auto& x, const auto& y) {
+        using Scalar = typename std::decay_t<decltype(x)>::Scalar;
+        if constexpr (Kind == CorrelationKind::Pearson) return dependence::Correlation<Scalar>::pearson(x, y);
+        else if constexpr (Kind == CorrelationKind::Spearman) return dependence::Correlation<Scalar>::spearman(x, y);
+        else return dependence::Correlation<Scalar>::kendall_tau(x, y);
+    };
+    T value = 0;
+
+    for (auto _ : state) {
+        value = compute(panel.col(0), panel.col(1));
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    const auto ref_panel = return_panel<double>(state.range(0), 2);
+    report_accuracy<T>(state, value, compute(ref_panel.col(0), ref_panel.col(1)));
+}
+
+// {维度, 样本数}，维度增大时减少样本数以控制单次耗时
+void copula_sizes(benchmark::internal::Benchmark* b) {
+    b->Args({10, 10'000})->Args({100, 10'000})->Args({1'000, 1'000})->Args({5'000, 100})->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_TEMPLATE(BM_GaussianCopula, double)->Apply(copula_sizes);
+BENCHMARK_TEMPLATE(BM_GaussianCopula, float)->Apply(copula_sizes);
+BENCHMARK_TEMPLATE(BM_StudentTCopula, double)->Apply(copula_sizes);
+BENCHMARK_TEMPLATE(BM_StudentTCopula, float)->Apply(copula_sizes);
+
+BENCHMARK_TEMPLATE(BM_Correlation, double, CorrelationKind::Pearson)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+BENCHMARK_TEMPLATE(BM_Correlation, float, CorrelationKind::Pearson)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+BENCHMARK_TEMPLATE(BM_Correlation, double, CorrelationKind::Spearman)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+BENCHMARK_TEMPLATE(BM_Correlation, float, CorrelationKind::Spearman)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+// Kendall's tau 为 O(T^2)
+BENCHMARK_TEMPLATE(BM_Correlation, double, CorrelationKind::Kendall)->RangeMultiplier(10)->Range(100, 10'000);
+BENCHMARK_TEMPLATE(BM_Correlation, float, CorrelationKind::Kendall)->RangeMultiplier(10)->Range(100, 10'000);
+
+} // namespace openrisk::bench
@@ -0,0 +1,129 @@
+#include "bench_common.hpp"
+#include "openrisk/factor/covariance.hpp"
+#include "openrisk/factor/portfolio_risk.hpp"
+#include "../src/factor/attribution.hpp"
+
+namespace openrisk::bench {
+
+// {T, N}：一年到五年日频、100 到 5000 个资产
+void panel_sizes(benchmark::internal::Benchmark* b) {
+    b->Args({250, 100})->Args({1'260, 500})->Args({1'260, 1'000})->Args({1'260, 5'000})->Unit(benchmark::kMillisecond);
+}
+
+template <core::FloatingPoint T>
+void BM_SampleCovariance(benchmark::State& state) {
+    const auto panel = return_panel<T>(state.range(0), state.range(1));
+    Eigen::MatrixX<T> cov(state.range(1), state.range(1));
+
+    for (auto _ : state) {
+        factor::CovarianceEstimator<T>::sample_covariance(panel, cov);
+        benchmark::DoNotOptimize(cov.data());
+    }
+
+    const auto ref = factor::CovarianceEstimator<double>::sample_covariance(return_panel<double>(state.range(0), state.range(1)));
+    report_accuracy<T>(state, cov, ref);
+}
+
+template <core::FloatingPoint T>
+void BM_LedoitWolf(benchmark::State& state) {
+    const auto panel = return_panel<T>(state.range(0), state.range(1));
+    Eigen::MatrixX<T> cov;
+
+    for (auto _ : state) {
+        cov = factor::CovarianceEstimator<T>::ledoit_wolf_shrinkage(panel);
+        benchmark::DoNotOptimize(cov.data());
+    }
+
+    const auto ref = factor::CovarianceEstimator<double>::ledoit_wolf_shrinkage(return_panel<double>(state.range(0), state.range(1)));
+    report_accuracy<T>(state, cov, ref);
+}
+
+/**
+ * @brief 单笔 what-if：PortfolioRisk 增量评估 vs RiskAttribution 全量重算
+ * Args: {N, K, 每笔调仓涉及的资产数}
+ */
+template <core::FloatingPoint T>
+struct FactorModel {
+    Eigen::MatrixX<T> beta;
+    Eigen::MatrixX<T> factor_cov;
+    Eigen::VectorX<T> specific_var;
+    Eigen::VectorX<T> weights;
+    std::vector<factor::TradeProposal<T>> trades;
+};
+
+template <core::FloatingPoint T>
+FactorModel<T> factor_model(std::size_t n, std::size_t k, std::size_t touched, std::size_t n_trades) {
+    core::RandomEngine<double> rng(42);
+    FactorModel<T> m;
+    Eigen::MatrixXd beta = Eigen::MatrixXd::NullaryExpr(n, k, [&] { return rng.next_uniform() - 0.5; });
+    Eigen::MatrixXd a = Eigen::MatrixXd::NullaryExpr(k, k, [&] { return 0.01 * (rng.next_uniform() - 0.5); });
+    m.beta = beta.cast<T>();
+    m.factor_cov = (a * a.transpose() + 1e-4 * Eigen::MatrixXd::Identity(k, k)).cast<T>();
+    m.specific_var = Eigen::VectorX<T>::Constant(n, T(4e-4));
+    m.weights = Eigen::VectorX<T>::Constant(n, T(1) / static_cast<T>(n));
+    m.trades.resize(n_trades);
+    for (auto& trade : m.trades) {
+        for (std::size_t j = 0; j < touched; ++j) {
+            trade.assets.push_back(static_cast<Eigen::Index>(rng.next_uniform() * (n - 1)));
+            trade.deltas.push_back(static_cast<T>(0.001 * (rng.next_uniform() - 0.5)));
+        }
+    }
+    return m;
+}
+
+template <core::FloatingPoint T>
+void BM_WhatIfIncremental(benchmark::State& state) {
+    const auto m = factor_model<T>(state.range(0), state.range(1), state.range(2), 1024);
+    const factor::PortfolioRisk<T> risk(m.beta, m.factor_cov, m.specific_var, m.weights);
+    std::size_t c = 0;
+
+    for (auto _ : state) {
+        T v = risk.what_if_variance(m.trades[c++ & 1023]);
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <core::FloatingPoint T>
+void BM_WhatIfFullRecompute(benchmark::State& state) {
+    const auto m = factor_model<T>(state.range(0), state.range(1), state.range(2), 1024);
+    Eigen::VectorX<T> w = m.weights;
+    std::size_t c = 0;
+
+    for (auto _ : state) {
+        const auto& trade = m.trades[c++ & 1023];
+        for (std::size_t j = 0; j < trade.assets.size(); ++j) w(trade.assets[j]) += trade.deltas[j];
+        T v = factor::RiskAttribution<T>::total_variance(w, m.beta, m.factor_cov, m.specific_var);
+        for (std::size_t j = 0; j < trade.assets.size(); ++j) w(trade.assets[j]) -= trade.deltas[j];
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <core::FloatingPoint T>
+void BM_WhatIfBatch(benchmark::State& state) {
+    const auto m = factor_model<T>(state.range(0), state.range(1), state.range(2), 10'000);
+    const factor::PortfolioRisk<T> risk(m.beta, m.factor_cov, m.specific_var, m.weights);
+    core::WorkerPool pool;
+
+    for (auto _ : state) {
+        auto v = risk.what_if_variance(m.trades, pool);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * m.trades.size());
+}
+
+void what_if_sizes(benchmark::internal::Benchmark* b) {
+    b->Args({1'000, 40, 5})->Args({5'000, 80, 5})->Args({5'000, 80, 50});
+}
+
+BENCHMARK_TEMPLATE(BM_SampleCovariance, double)->Apply(panel_sizes);
+BENCHMARK_TEMPLATE(BM_SampleCovariance, float)->Apply(panel_sizes);
+BENCHMARK_TEMPLATE(BM_LedoitWolf, double)->Apply(panel_sizes);
+BENCHMARK_TEMPLATE(BM_LedoitWolf, float)->Apply(panel_sizes);
+
+BENCHMARK_TEMPLATE(BM_WhatIfIncremental, double)->Apply(what_if_sizes);
+BENCHMARK_TEMPLATE(BM_WhatIfFullRecompute, double)->Apply(what_if_sizes);
+BENCHMARK_TEMPLATE(BM_WhatIfBatch, double)->Apply(what_if_sizes)->Unit(benchmark::kMillisecond);
+
+} // namespace openrisk::bench
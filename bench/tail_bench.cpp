@@ -0,0 +1,57 @@
+#include "bench_common.hpp"
+#include "openrisk/tail/var.hpp"
+
+namespace openrisk::bench {
+
+template <core::FloatingPoint T>
+void BM_HistoricalVaR(benchmark::State& state) {
+    const auto returns = garch_returns<T>(state.range(0));
+    Eigen::VectorX<T> scratch;
+    T value = 0;
+
+    for (auto _ : state) {
+        value = tail::RiskMetrics<T>::historical_var(returns, T(0.99), scratch);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    report_accuracy<T>(state, value, tail::RiskMetrics<double>::historical_var(garch_returns<double>(state.range(0)), 0.99));
+}
+
+template <core::FloatingPoint T>
+void BM_ParametricVaR(benchmark::State& state) {
+    const auto returns = garch_returns<T>(state.range(0));
+    T value = 0;
+
+    for (auto _ : state) {
+        value = tail::RiskMetrics<T>::parametric_var(returns, T(0.99));
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    report_accuracy<T>(state, value, tail::RiskMetrics<double>::parametric_var(garch_returns<double>(state.range(0)), 0.99));
+}
+
+template <core::FloatingPoint T>
+void BM_ExpectedShortfall(benchmark::State& state) {
+    const auto returns = garch_returns<T>(state.range(0));
+    Eigen::VectorX<T> scratch;
+    T value = 0;
+
+    for (auto _ : state) {
+        value = tail::RiskMetrics<T>::expected_shortfall(returns, T(0.975), scratch);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    report_accuracy<T>(state, value, tail::RiskMetrics<double>::expected_shortfall(garch_returns<double>(state.range(0)), 0.975));
+}
+
+BENCHMARK_TEMPLATE(BM_HistoricalVaR, double)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+BENCHMARK_TEMPLATE(BM_HistoricalVaR, float)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+BENCHMARK_TEMPLATE(BM_ParametricVaR, double)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+BENCHMARK_TEMPLATE(BM_ParametricVaR, float)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+BENCHMARK_TEMPLATE(BM_ExpectedShortfall, double)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+BENCHMARK_TEMPLATE(BM_ExpectedShortfall, float)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+
+} // namespace openrisk::bench
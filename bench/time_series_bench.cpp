@@ -0,0 +1,170 @@
+#include "bench_common.hpp"
+#include "openrisk/time_series/garch.hpp"
+
+namespace openrisk::bench {
+
+template <core::FloatingPoint T>
+void BM_GarchFilter(benchmark::State& state) {
+    const auto returns = garch_returns<T>(state.range(0));
+    const time_series::GarchParams<T> params{T(2e-6), T(0.08), T(0.9)};
+    Eigen::VectorX<T> sigmas_sq(returns.size());
+
+    for (auto _ : state) {
+        time_series::GarchModel<T>::filter(returns, params, sigmas_sq);
+        benchmark::DoNotOptimize(sigmas_sq.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    const auto ref = time_series::GarchModel<double>::filter(garch_returns<double>(state.range(0)), {2e-6, 0.08, 0.9});
+    report_accuracy<T>(state, sigmas_sq.template cast<double>().sum(), ref.sum());
+}
+
+template <core::FloatingPoint T>
+void BM_GarchLogLikelihood(benchmark::State& state) {
+    const auto returns = garch_returns<T>(state.range(0));
+    const time_series::GarchParams<T> params{T(2e-6), T(0.08), T(0.9)};
+    T value = 0;
+
+    for (auto _ : state) {
+        value = time_series::GarchModel<T>::log_likelihood(returns, params);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    const double ref = time_series::GarchModel<double>::log_likelihood(garch_returns<double>(state.range(0)), {2e-6, 0.08, 0.9});
+    report_accuracy<T>(state, value, ref);
+}
+
+/**
+ * @brief 默认配置 (L-BFGS) 的标定耗时
+ * evals 为单次标定的目标函数调用次数，unconverged 非零说明计时的不是一次完整的优化
+ */
+template <core::FloatingPoint T>
+void BM_GarchCalibrate(benchmark::State& state) {
+    const auto returns = garch_returns<T>(state.range(0));
+    time_series::GarchCalibrationConfig<T> config;
+    core::OptimizationStats<core::accumulator_t<T>> stats;
+    config.stats = &stats;
+    time_series::GarchParams<T> params{};
+
+    for (auto _ : state) {
+        params = time_series::calibrate_garch<T>(returns, config);
+        benchmark::DoNotOptimize(params);
+    }
+
+    state.counters["nll"] = time_series::GarchModel<T>::template log_likelihood<double>(
+        returns, {params.omega, params.alpha, params.beta});
+    state.counters["evals"] = static_cast<double>(stats.objective_evaluations);
+    state.counters["unconverged"] = static_cast<double>(stats.unconverged_runs);
+    const auto ref = time_series::calibrate_garch<double>(garch_returns<double>(state.range(0)));
+    report_accuracy<T>(state, params.alpha + params.beta, ref.alpha + ref.beta);
+}
+
+/**
+ * @brief 各优化引擎的标定耗时与所得负对数似然 (nll 越小越好)
+ */
+void BM_GarchCalibrateOptimizer(benchmark::State& state) {
+    const auto returns = garch_returns<double>(state.range(0));
+    time_series::GarchCalibrationConfig<double> config;
+    config.optimizer = static_cast<core::OptimizerKind>(state.range(1));
+    core::OptimizationStats<double> stats;
+    config.stats = &stats;
+    time_series::GarchParams<double> params{};
+
+    for (auto _ : state) {
+        params = time_series::calibrate_garch<double>(returns, config);
+        benchmark::DoNotOptimize(params);
+    }
+
+    state.counters["nll"] = time_series::GarchModel<double>::log_likelihood(returns, params);
+    state.counters["evals"] = static_cast<double>(stats.objective_evaluations);
+    state.counters["unconverged"] = static_cast<double>(stats.unconverged_runs);
+}
+
+/**
+ * @brief 各 GARCH 变体在与 garch_returns 相近的无条件方差下的参数
+ */
+template <time_series::GarchVariant V, time_series::Innovation I>
+time_series::GarchParams<double> variant_params() {
+    time_series::GarchParams<double> params{2e-6, 0.08, 0.9};
+    if constexpr (V == time_series::GarchVariant::GJR) params = {2e-6, 0.03, 0.9, 0.1};
+    if constexpr (V == time_series::GarchVariant::EGARCH) params = {-0.17, 0.15, 0.98, -0.06};
+    if constexpr (I == time_series::Innovation::StudentT) params.nu = 6.0;
+    return params;
+}
+
+/**
+ * @brief 单资产成本计数器：sec_per_asset = 总耗时 / (迭代次数 x 资产数)
+ */
+inline void report_per_asset(benchmark::State& state, int64_t assets) {
+    state.SetItemsProcessed(state.iterations() * assets);
+    state.counters["sec_per_asset"] = benchmark::Counter(
+        static_cast<double>(assets), benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+/**
+ * @brief 面板负对数似然 (2000 x N)，按列并行
+ */
+template <time_series::GarchVariant V, time_series::Innovation I>
+void BM_GarchVariantLogLikelihood(benchmark::State& state) {
+    using Model = time_series::GarchModel<double, V, I>;
+    const auto returns = garch_panel<double>(2'000, state.range(0));
+    const std::vector<time_series::GarchParams<double>> params(state.range(0), variant_params<V, I>());
+    Eigen::VectorXd values;
+
+    for (auto _ : state) {
+        values = Model::log_likelihood_panel(returns, params);
+        benchmark::DoNotOptimize(values.data());
+    }
+    report_per_asset(state, state.range(0));
+}
+
+/**
+ * @brief 面板标定 (1000 x N)，默认引擎，按列并行
+ * nll 为各列负对数似然的均值，unconverged 为未满足收敛判据的列数 (应为 0)
+ */
+template <time_series::GarchVariant V, time_series::Innovation I>
+void BM_GarchVariantCalibrate(benchmark::State& state) {
+    using Model = time_series::GarchModel<double, V, I>;
+    const auto returns = garch_panel<double>(1'000, state.range(0));
+    time_series::GarchCalibrationConfig<double> config;
+    config.variant = V;
+    config.innovation = I;
+    core::OptimizationStats<double> stats;
+    config.stats = &stats;
+    std::vector<time_series::GarchParams<double>> params;
+
+    for (auto _ : state) {
+        params = time_series::calibrate_garch_panel<double>(returns, config);
+        benchmark::DoNotOptimize(params.data());
+    }
+    report_per_asset(state, state.range(0));
+    state.counters["nll"] = Model::log_likelihood_panel(returns, params).mean();
+    state.counters["unconverged"] = static_cast<double>(stats.unconverged_runs);
+}
+
+BENCHMARK_TEMPLATE(BM_GarchFilter, double)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+BENCHMARK_TEMPLATE(BM_GarchFilter, float)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+BENCHMARK_TEMPLATE(BM_GarchLogLikelihood, double)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+BENCHMARK_TEMPLATE(BM_GarchLogLikelihood, float)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+BENCHMARK_TEMPLATE(BM_GarchCalibrate, double)->RangeMultiplier(10)->Range(1'000, 1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GarchCalibrate, float)->RangeMultiplier(10)->Range(1'000, 1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GarchCalibrateOptimizer)
+    ->Apply([](benchmark::internal::Benchmark* b) { optimizer_kinds(b, {1'000, 10'000}); })
+    ->Unit(benchmark::kMillisecond);
+
+#define OPENRISK_GARCH_VARIANT_BENCHMARKS(V, I)                                                                   \
+    BENCHMARK_TEMPLATE(BM_GarchVariantLogLikelihood, time_series::GarchVariant::V, time_series::Innovation::I)   \
+        ->RangeMultiplier(8)->Range(1, 512)->UseRealTime();                                                      \
+    BENCHMARK_TEMPLATE(BM_GarchVariantCalibrate, time_series::GarchVariant::V, time_series::Innovation::I)       \
+        ->RangeMultiplier(8)->Range(1, 64)->UseRealTime()->Unit(benchmark::kMillisecond)
+
+OPENRISK_GARCH_VARIANT_BENCHMARKS(Symmetric, Gaussian);
+OPENRISK_GARCH_VARIANT_BENCHMARKS(Symmetric, StudentT);
+OPENRISK_GARCH_VARIANT_BENCHMARKS(GJR, Gaussian);
+OPENRISK_GARCH_VARIANT_BENCHMARKS(GJR, StudentT);
+OPENRISK_GARCH_VARIANT_BENCHMARKS(EGARCH, Gaussian);
+OPENRISK_GARCH_VARIANT_BENCHMARKS(EGARCH, StudentT);
+
+} // namespace openrisk::bench
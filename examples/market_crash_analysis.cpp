@@ -0,0 +1,43 @@
+#include "openrisk/core/random.hpp"
+#include "openrisk/core/stats.hpp"
+#include "openrisk/crash/lppl.hpp"
+#include "openrisk/tail/var.hpp"
+#include "openrisk/time_series/garch.hpp"
+#include <iostream>
+
+using namespace openrisk;
+
+/**
+ * @brief 示例：对一段合成的泡沫行情做 LPPL 崩盘预警、GARCH 波动率与尾部风险分析
+ */
+int main() {
+    const std::size_t n = 500;
+    const crash::LPPLParams<double> truth{8.0, -0.5, 0.02, 520.0, 0.4, 9.0, 1.0};
+
+    core::RandomEngine<double> rng(2024);
+    Eigen::VectorXd noise = rng.next_normal_vector(n);
+    Eigen::VectorXd t(n);
+    Eigen::VectorXd log_p(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        t(i) = static_cast<double>(i);
+        log_p(i) = crash::LPPLModel<double>::compute(t(i), truth) + 0.01 * noise(i);
+    }
+
+    crash::LPPLCalibrationConfig<double> lppl_config;
+    lppl_config.optimizer = core::OptimizerKind::NelderMead; // 变量投影 + 网格多起点
+    auto lppl = crash::LPPLCalibrator<double>::calibrate(t, log_p, t(n - 1), lppl_config);
+    std::cout << "LPPL: tc = " << lppl.tc << ", m = " << lppl.m << ", omega = " << lppl.omega
+              << (crash::LPPLModel<double>::is_bubble_present(lppl) ? "  [bubble]" : "") << "\n";
+
+    Eigen::VectorXd returns = log_p.tail(n - 1) - log_p.head(n - 1);
+    Eigen::VectorXd demeaned = returns.array() - core::Statistics<double>::mean(returns);
+
+    auto garch = time_series::calibrate_garch<double>(demeaned);
+    Eigen::VectorXd sigmas_sq = time_series::GarchModel<double>::filter(demeaned, garch);
+    std::cout << "GARCH: omega = " << garch.omega << ", alpha = " << garch.alpha << ", beta = " << garch.beta
+              << ", last vol = " << std::sqrt(sigmas_sq(sigmas_sq.size() - 1)) << "\n";
+
+    std::cout << "VaR(99%) = " << tail::RiskMetrics<double>::historical_var(returns, 0.99)
+              << ", ES(97.5%) = " << tail::RiskMetrics<double>::expected_shortfall(returns, 0.975) << "\n";
+    return 0;
+}
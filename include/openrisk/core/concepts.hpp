@@ -1,5 +1,9 @@
 #pragma once
+#include <bit>
 #include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
 #include <Eigen/Dense>
 
 namespace openrisk::core {
@@ -10,6 +14,26 @@ namespace openrisk::core {
 template <typename T>
 concept FloatingPoint = std::is_floating_point_v<T>;
 
+/**
+ * @brief 混合精度累加类型：float 数据以 double 累加，其余类型保持不变
+ */
+template <FloatingPoint T>
+using accumulator_t = std::conditional_t<(sizeof(T) < sizeof(double)), double, T>;
+
+/**
+ * @brief 按位判断 float / double 是否有限 (非 NaN、非无穷)
+ * 库以 -ffast-math 编译，编译器假定不存在 NaN / Inf，std::isfinite 与基于比较的判断都可能被折叠，
+ * 因此直接检查 IEEE 754 指数位是否全为 1。
+ */
+template <FloatingPoint T>
+    requires std::same_as<T, float> || std::same_as<T, double>
+constexpr bool is_finite(T x) noexcept {
+    using Bits = std::conditional_t<sizeof(T) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
+    constexpr int mantissa_bits = std::numeric_limits<T>::digits - 1;
+    constexpr Bits exponent_mask = ((Bits(1) << (sizeof(T) * 8 - 1)) - 1) & ~((Bits(1) << mantissa_bits) - 1);
+    return (std::bit_cast<Bits>(x) & exponent_mask) != exponent_mask;
+}
+
 /**
  * @brief 约束类型必须为 Eigen 的列向量
  */
@@ -20,4 +44,28 @@ concept EigenVector = requires(T v) {
     { v(0) } -> std::convertible_to<typename T::Scalar>;
 };
 
+/**
+ * @brief 标量类型为 T 的 Eigen 列向量 (含 Map、Ref、Block 及惰性表达式)
+ */
+template <typename V, typename T>
+concept EigenVectorOf = EigenVector<V> && std::same_as<typename V::Scalar, T>;
+
+/**
+ * @brief 只读向量 / 矩阵视图，可直接绑定 VectorX、矩阵列、Eigen::Map 等而不产生拷贝
+ */
+template <FloatingPoint T>
+using ConstVectorRef = Eigen::Ref<const Eigen::VectorX<T>>;
+
+template <FloatingPoint T>
+using ConstMatrixRef = Eigen::Ref<const Eigen::MatrixX<T>>;
+
+/**
+ * @brief 可写向量 / 矩阵视图，用于输出参数重载，调用方预先分配好存储
+ */
+template <FloatingPoint T>
+using VectorRef = Eigen::Ref<Eigen::VectorX<T>>;
+
+template <FloatingPoint T>
+using MatrixRef = Eigen::Ref<Eigen::MatrixX<T>>;
+
 } // namespace openrisk::core
@@ -0,0 +1,47 @@
+#pragma once
+#include "optimization.hpp"
+#include <cstdint>
+#include <stdexcept>
+
+namespace openrisk::core {
+
+/**
+ * @brief 差分进化 (DE/rand/1/bin)，种群在多个线程上并行评估
+ *
+ * 全局搜索，不依赖梯度，适合多峰目标函数。需要上下界 (为空时以 x0 为中心取
+ * x0 ± (|x0| + 1))。目标函数会被多个线程同时调用，必须是线程安全的。
+ * 给定 seed 时结果与线程数无关。工作线程在每次 minimize 开始时创建一次，各代复用。
+ */
+template <FloatingPoint T = double>
+class DifferentialEvolutionOptimizer : public Optimizer<T> {
+public:
+    struct Config {
+        int population = 0;             // 种群大小，0 表示 10 * 维数 (至少 20)；否则至少为 4
+        int max_generations = 300;      // 最大代数
+        T mutation = 0.7;               // 差分权重 F
+        T crossover = 0.9;              // 交叉概率 CR
+        T f_tol = 1e-10;                // 种群函数值极差阈值
+        uint32_t seed = 42;             // 随机种子
+        std::size_t threads = 0;        // 线程数，0 表示硬件并发数
+    };
+
+    /**
+     * @throws std::invalid_argument population 为 1-3 或负数 (rand/1 变异需要三个互不相同的其他个体)
+     */
+    explicit DifferentialEvolutionOptimizer(Config config = Config()) : config_(config) {
+        if (config_.population != 0 && config_.population < 4) {
+            throw std::invalid_argument("DifferentialEvolutionOptimizer: population must be 0 or at least 4");
+        }
+    }
+
+    OptimizationResult<T> minimize(
+        ObjectiveFunc<T> func,
+        const Eigen::VectorX<T>& x0,
+        const Eigen::VectorX<T>& lower_bounds,
+        const Eigen::VectorX<T>& upper_bounds) override;
+
+private:
+    Config config_;
+};
+
+} // namespace openrisk::core
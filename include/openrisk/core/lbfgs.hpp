@@ -11,6 +11,7 @@ public:
         int m = 10;                     // 记忆历史步数
         int max_iter = 500;             // 最大迭代次数
         T g_tol = 1e-6;                 // 梯度收敛阈值
+        T f_tol = 1e-10;                // 相对函数值下降收敛阈值 (有限差分梯度噪声常高于 g_tol)
         T step_alpha = 1.0;             // 初始步长
         T wolfe_c1 = 1e-4;              // Wolfe 准则参数 1
         T wolfe_c2 = 0.9;               // Wolfe 准则参数 2
@@ -35,13 +36,19 @@ private:
 
     Eigen::VectorX<T> compute_direction(const Eigen::VectorX<T>& g, const std::deque<StepHistory>& history);
 
-    T line_search(ObjectiveFunc<T> func, 
+    /**
+     * @brief Armijo 回溯线搜索，phi_0 为 func(x)，接受步长处的函数值写入 phi_step
+     */
+    T line_search(const ObjectiveFunc<T>& func, 
                   const Eigen::VectorX<T>& x, 
+                  T phi_0,
                   const Eigen::VectorX<T>& g, 
                   const Eigen::VectorX<T>& d,
-                  T initial_step);
+                  T initial_step,
+                  T& phi_step,
+                  OptimizationStats<T>& stats);
     
-    Eigen::VectorX<T> estimate_gradient(ObjectiveFunc<T> func, const Eigen::VectorX<T>& x);
+    Eigen::VectorX<T> estimate_gradient(const ObjectiveFunc<T>& func, const Eigen::VectorX<T>& x, OptimizationStats<T>& stats);
 };
 
 } // namespace openrisk::core
@@ -0,0 +1,38 @@
+#pragma once
+#include "optimization.hpp"
+#include <vector>
+
+namespace openrisk::core {
+
+/**
+ * @brief Nelder-Mead 单纯形法 (无需梯度)
+ * 适合带硬约束墙 (如返回 1e10 的非法区域) 或崎岖的低维目标函数。
+ * 提供上下界时，所有试探点都会被截断到边界内。
+ */
+template <FloatingPoint T = double>
+class NelderMeadOptimizer : public Optimizer<T> {
+public:
+    struct Config {
+        int max_iter = 2000;            // 最大迭代次数
+        T f_tol = 1e-10;                // 单纯形顶点函数值极差阈值
+        T x_tol = 1e-8;                 // 单纯形直径阈值
+        T initial_step = 0.05;          // 初始单纯形相对步长
+        T reflection = 1.0;             // 反射系数
+        T expansion = 2.0;              // 扩张系数
+        T contraction = 0.5;            // 收缩系数
+        T shrink = 0.5;                 // 整体收缩系数
+    };
+
+    explicit NelderMeadOptimizer(Config config = Config()) : config_(config) {}
+
+    OptimizationResult<T> minimize(
+        ObjectiveFunc<T> func,
+        const Eigen::VectorX<T>& x0,
+        const Eigen::VectorX<T>& lower_bounds,
+        const Eigen::VectorX<T>& upper_bounds) override;
+
+private:
+    Config config_;
+};
+
+} // namespace openrisk::core
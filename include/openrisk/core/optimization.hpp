@@ -1,9 +1,21 @@
 #pragma once
 #include "concepts.hpp"
+#include <chrono>
 #include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 优化器遥测开关，0 时计数与计时代码在编译期被完全移除
+ */
+#ifndef OPENRISK_ENABLE_TELEMETRY
+#define OPENRISK_ENABLE_TELEMETRY 1
+#endif
 
 namespace openrisk::core {
 
+inline constexpr bool telemetry_enabled = OPENRISK_ENABLE_TELEMETRY != 0;
+
 /**
  * @brief 优化目标函数定义
  * 输入参数向量，返回标量 Loss
@@ -11,12 +23,88 @@ namespace openrisk::core {
 template <FloatingPoint T = double>
 using ObjectiveFunc = std::function<T(const Eigen::VectorX<T>&)>;
 
+/**
+ * @brief 单次迭代结束时的状态
+ */
+template <FloatingPoint T = double>
+struct IterationRecord {
+    int iteration;      // 从 0 开始
+    T value;            // 本次迭代后的目标函数值
+    T gradient_norm;    // 本次迭代后的梯度范数
+    T step;             // L-BFGS: 线搜索步长；Nelder-Mead: 单纯形直径；DE: 种群函数值极差
+};
+
+/**
+ * @brief 优化过程遥测数据，OPENRISK_ENABLE_TELEMETRY=0 时保持为零
+ */
+template <FloatingPoint T = double>
+struct OptimizationStats {
+    long objective_evaluations = 0;
+    long gradient_evaluations = 0;
+    long line_search_backtracks = 0;
+    long line_search_failures = 0;  // 回溯次数耗尽仍未满足 Armijo 条件
+    long history_resets = 0;        // 非下降方向或线搜索失败时清空曲率历史
+    long unconverged_runs = 0;      // 未满足收敛判据就结束 (迭代上限、线搜索失败或回调终止) 的运行次数，不受遥测开关影响
+    double gradient_seconds = 0.0;
+    double line_search_seconds = 0.0;
+    std::vector<IterationRecord<T>> trajectory; // 仅在开启轨迹记录时填充
+};
+
+/**
+ * @brief 把一次优化的遥测累加到 into 上 (多起点标定时汇总各次运行)
+ */
+template <FloatingPoint T>
+void merge_stats(OptimizationStats<T>& into, const OptimizationStats<T>& from) {
+    into.objective_evaluations += from.objective_evaluations;
+    into.gradient_evaluations += from.gradient_evaluations;
+    into.line_search_backtracks += from.line_search_backtracks;
+    into.line_search_failures += from.line_search_failures;
+    into.history_resets += from.history_resets;
+    into.unconverged_runs += from.unconverged_runs;
+    into.gradient_seconds += from.gradient_seconds;
+    into.line_search_seconds += from.line_search_seconds;
+    into.trajectory.insert(into.trajectory.end(), from.trajectory.begin(), from.trajectory.end());
+}
+
 template <FloatingPoint T = double>
 struct OptimizationResult {
     Eigen::VectorX<T> x_best;
     T min_value;
-    int iterations;
-    bool converged;
+    int iterations = 0;
+    bool converged = false;
+    OptimizationStats<T> stats;
+};
+
+/**
+ * @brief 迭代回调接口
+ * 每次迭代结束后同步调用，返回 false 时优化器提前终止。回调运行在优化线程上，应保持轻量。
+ */
+template <FloatingPoint T = double>
+class OptimizationObserver {
+public:
+    virtual ~OptimizationObserver() = default;
+    virtual bool on_iteration(const IterationRecord<T>& record) = 0;
+};
+
+/**
+ * @brief 累加计时器，析构时把经过的时间加到 target 上；遥测关闭时为空操作
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(double& target) : target_(target) {
+        if constexpr (telemetry_enabled) start_ = std::chrono::steady_clock::now();
+    }
+    ~ScopedTimer() {
+        if constexpr (telemetry_enabled) {
+            target_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+        }
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    double& target_;
+    std::chrono::steady_clock::time_point start_;
 };
 
 /**
@@ -27,10 +115,50 @@ class Optimizer {
 public:
     virtual ~Optimizer() = default;
     virtual OptimizationResult<T> minimize(
-        ObjectiveFunc<T> func, 
+        ObjectiveFunc<T> func,
         const Eigen::VectorX<T>& x0,
         const Eigen::VectorX<T>& lower_bounds,
         const Eigen::VectorX<T>& upper_bounds) = 0;
+
+    /**
+     * @brief 挂接迭代回调 (不转移所有权，传 nullptr 取消)
+     */
+    void set_observer(OptimizationObserver<T>* observer) { observer_ = observer; }
+
+    /**
+     * @brief 是否在 OptimizationStats::trajectory 中记录逐次迭代轨迹
+     */
+    void set_record_trajectory(bool enabled) { record_trajectory_ = enabled; }
+
+protected:
+    OptimizationObserver<T>* observer_ = nullptr;
+    bool record_trajectory_ = false;
+
+    /**
+     * @brief 迭代结束时由具体优化器调用，返回 false 表示回调要求终止
+     */
+    bool notify_iteration(OptimizationStats<T>& stats, const IterationRecord<T>& record) {
+        if constexpr (telemetry_enabled) {
+            if (record_trajectory_) stats.trajectory.push_back(record);
+        }
+        return observer_ ? observer_->on_iteration(record) : true;
+    }
+};
+
+/**
+ * @brief 可选的优化引擎
+ */
+enum class OptimizerKind {
+    LBFGS,                  // 有限差分梯度 + L-BFGS，光滑目标函数
+    NelderMead,             // 单纯形法，无需梯度，适合带约束墙的低维问题
+    DifferentialEvolution,  // 差分进化，种群并行评估，适合多峰问题
 };
 
+/**
+ * @brief 按类型构造默认配置的优化器
+ * @param threads 差分进化评估种群的线程数上限，0 表示硬件并发数；其他引擎忽略
+ */
+template <FloatingPoint T = double>
+std::unique_ptr<Optimizer<T>> make_optimizer(OptimizerKind kind, std::size_t threads = 0);
+
 } // namespace openrisk::core
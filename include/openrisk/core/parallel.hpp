@@ -0,0 +1,177 @@
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace openrisk::core {
+
+/**
+ * @brief 将 [begin, end) 切分为连续块，在多个线程上并行执行 func(i)
+ * @param min_chunk 每个线程至少处理的元素个数，任务过小时直接在当前线程串行执行
+ * @param max_threads 线程数上限，0 表示使用 std::thread::hardware_concurrency()
+ *
+ * func 需要是线程安全的；任意线程抛出的第一个异常会在所有线程结束后重新抛出。
+ */
+template <typename Func>
+void parallel_for(std::size_t begin, std::size_t end, Func&& func,
+                  std::size_t min_chunk = 1, std::size_t max_threads = 0) {
+    if (end <= begin) return;
+    const std::size_t n = end - begin;
+
+    std::size_t hw = max_threads ? max_threads : std::thread::hardware_concurrency();
+    hw = std::max<std::size_t>(hw, 1);
+    const std::size_t n_threads = std::min(hw, std::max<std::size_t>(n / std::max<std::size_t>(min_chunk, 1), 1));
+
+    if (n_threads <= 1) {
+        for (std::size_t i = begin; i < end; ++i) func(i);
+        return;
+    }
+
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto worker = [&](std::size_t lo, std::size_t hi) {
+        try {
+            for (std::size_t i = lo; i < hi; ++i) func(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads - 1);
+    const std::size_t chunk = n / n_threads;
+    const std::size_t remainder = n % n_threads;
+
+    std::size_t lo = begin;
+    for (std::size_t t = 0; t < n_threads; ++t) {
+        std::size_t hi = lo + chunk + (t < remainder ? 1 : 0);
+        if (t + 1 == n_threads) {
+            worker(lo, hi); // 最后一块由调用线程执行
+        } else {
+            threads.emplace_back(worker, lo, hi);
+        }
+        lo = hi;
+    }
+    for (auto& th : threads) th.join();
+
+    if (error) std::rethrow_exception(error);
+}
+
+/**
+ * @brief 常驻工作线程池，供反复执行的并行循环 (如差分进化的每一代) 复用线程
+ *
+ * 构造时启动 size() - 1 个工作线程，析构时回收；parallel_for 的切分方式与
+ * 自由函数 parallel_for 相同，最后一块由调用线程执行。同一时刻只能由一个线程调用
+ * parallel_for。
+ */
+class WorkerPool {
+public:
+    /**
+     * @param max_threads 线程数上限 (含调用线程)，0 表示使用 std::thread::hardware_concurrency()
+     */
+    explicit WorkerPool(std::size_t max_threads = 0) {
+        std::size_t n = max_threads ? max_threads : std::thread::hardware_concurrency();
+        n = std::max<std::size_t>(n, 1);
+        workers_.reserve(n - 1);
+        for (std::size_t w = 0; w + 1 < n; ++w) {
+            workers_.emplace_back([this, w] { run(w); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_.notify_all();
+        for (auto& th : workers_) th.join();
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    std::size_t size() const { return workers_.size() + 1; }
+
+    /**
+     * @brief 在池中并行执行 func(i)，i ∈ [begin, end)；min_chunk 与异常语义同自由函数 parallel_for
+     */
+    template <typename Func>
+    void parallel_for(std::size_t begin, std::size_t end, Func&& func, std::size_t min_chunk = 1) {
+        if (end <= begin) return;
+        const std::size_t n = end - begin;
+        const std::size_t n_threads = std::min(size(), std::max<std::size_t>(n / std::max<std::size_t>(min_chunk, 1), 1));
+        if (n_threads <= 1) {
+            for (std::size_t i = begin; i < end; ++i) func(i);
+            return;
+        }
+
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        const std::function<void(std::size_t)> block = [&](std::size_t t) {
+            const std::size_t lo = begin + t * n / n_threads;
+            const std::size_t hi = begin + (t + 1) * n / n_threads;
+            try {
+                for (std::size_t i = lo; i < hi; ++i) func(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+            }
+        };
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = &block;
+            active_ = n_threads - 1;
+            pending_ = active_;
+            ++generation_;
+        }
+        start_.notify_all();
+        block(n_threads - 1); // 最后一块由调用线程执行
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [&] { return pending_ == 0; });
+            job_ = nullptr;
+        }
+        if (error) std::rethrow_exception(error);
+    }
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    const std::function<void(std::size_t)>* job_ = nullptr;
+    std::size_t active_ = 0;     // 本轮参与的工作线程数
+    std::size_t pending_ = 0;    // 本轮尚未完成的工作线程数
+    std::size_t generation_ = 0; // 每提交一轮任务加一
+    bool stop_ = false;
+
+    void run(std::size_t w) {
+        std::size_t seen = 0;
+        for (;;) {
+            const std::function<void(std::size_t)>* job = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+                if (w >= active_) continue;
+                job = job_;
+            }
+            (*job)(w);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--pending_ == 0) done_.notify_one();
+            }
+        }
+    }
+};
+
+} // namespace openrisk::core
@@ -17,11 +17,18 @@ public:
      */
     Eigen::VectorX<T> next_normal_vector(std::size_t size) {
         Eigen::VectorX<T> vec(size);
+        fill_normal(vec);
+        return vec;
+    }
+
+    /**
+     * @brief 用标准正态随机数填充调用方提供的向量
+     */
+    void fill_normal(VectorRef<T> out) {
         std::normal_distribution<T> dist(0.0, 1.0);
-        for (std::size_t i = 0; i < size; ++i) {
-            vec(i) = dist(engine_);
+        for (Eigen::Index i = 0; i < out.size(); ++i) {
+            out(i) = dist(engine_);
         }
-        return vec;
     }
 
     /**
@@ -29,8 +36,8 @@ public:
      * @param mean 均值向量
      * @param cholesky_l 协方差矩阵的 Cholesky 分解下三角矩阵 L (LL^T = Sigma)
      */
-    Eigen::VectorX<T> next_multivariate_normal(const Eigen::VectorX<T>& mean, 
-                                              const Eigen::MatrixX<T>& cholesky_l) {
+    Eigen::VectorX<T> next_multivariate_normal(ConstVectorRef<T> mean, 
+                                              ConstMatrixRef<T> cholesky_l) {
         Eigen::VectorX<T> z = next_normal_vector(mean.size());
         return mean + cholesky_l * z;
     }
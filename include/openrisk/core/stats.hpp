@@ -7,41 +7,64 @@
 
 namespace openrisk::core {
 
+/**
+ * @brief 描述性统计
+ * 接受任意标量为 T 的 Eigen 向量 (VectorX、Map、矩阵列、segment 或惰性表达式)，不会拷贝输入；
+ * 求和在 accumulator_t<T> 精度下进行
+ */
 template <FloatingPoint T = double>
 class Statistics {
 public:
-    static T mean(const Eigen::VectorX<T>& data) {
-        return data.mean();
+    using Accumulator = accumulator_t<T>;
+
+    template <EigenVectorOf<T> V>
+    static T mean(const V& data) {
+        return static_cast<T>(accumulated_mean(data));
     }
 
-    static T variance(const Eigen::VectorX<T>& data, bool unbiased = true) {
-        if (data.size() < 2) return 0.0;
-        T avg = mean(data);
-        T sum_sq = (data.array() - avg).square().sum();
-        return sum_sq / (data.size() - (unbiased ? 1 : 0));
+    template <EigenVectorOf<T> V>
+    static T variance(const V& data, bool unbiased = true) {
+        return static_cast<T>(accumulated_variance(data, unbiased));
     }
 
-    static T standard_deviation(const Eigen::VectorX<T>& data) {
+    template <EigenVectorOf<T> V>
+    static T standard_deviation(const V& data) {
         return std::sqrt(variance(data));
     }
 
-    static T skewness(const Eigen::VectorX<T>& data) {
-        T n = static_cast<T>(data.size());
+    template <EigenVectorOf<T> V>
+    static T skewness(const V& data) {
+        Accumulator n = static_cast<Accumulator>(data.size());
         if (n < 3) return 0.0;
-        T avg = mean(data);
-        T std_dev = standard_deviation(data);
-        T m3 = (data.array() - avg).cube().sum() / n;
-        return m3 / std::pow(std_dev, 3);
+        Accumulator avg = accumulated_mean(data);
+        Accumulator std_dev = std::sqrt(accumulated_variance(data, true));
+        Accumulator m3 = (data.template cast<Accumulator>().array() - avg).cube().sum() / n;
+        return static_cast<T>(m3 / std::pow(std_dev, 3));
     }
 
-    static T kurtosis(const Eigen::VectorX<T>& data, bool excess = true) {
-        T n = static_cast<T>(data.size());
+    template <EigenVectorOf<T> V>
+    static T kurtosis(const V& data, bool excess = true) {
+        Accumulator n = static_cast<Accumulator>(data.size());
         if (n < 4) return 0.0;
-        T avg = mean(data);
-        T std_dev = standard_deviation(data);
-        T m4 = (data.array() - avg).pow(4).sum() / n;
-        T k = m4 / std::pow(std_dev, 4);
-        return excess ? k - 3.0 : k;
+        Accumulator avg = accumulated_mean(data);
+        Accumulator std_dev = std::sqrt(accumulated_variance(data, true));
+        Accumulator m4 = (data.template cast<Accumulator>().array() - avg).pow(4).sum() / n;
+        Accumulator k = m4 / std::pow(std_dev, 4);
+        return static_cast<T>(excess ? k - 3.0 : k);
+    }
+
+private:
+    template <EigenVectorOf<T> V>
+    static Accumulator accumulated_mean(const V& data) {
+        return data.template cast<Accumulator>().mean();
+    }
+
+    template <EigenVectorOf<T> V>
+    static Accumulator accumulated_variance(const V& data, bool unbiased) {
+        if (data.size() < 2) return 0.0;
+        Accumulator avg = accumulated_mean(data);
+        Accumulator sum_sq = (data.template cast<Accumulator>().array() - avg).square().sum();
+        return sum_sq / (data.size() - (unbiased ? 1 : 0));
     }
 };
 
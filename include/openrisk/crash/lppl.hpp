@@ -1,6 +1,8 @@
 #pragma once
-#include "../core/concepts.hpp"
+#include "../core/optimization.hpp"
+#include <algorithm>
 #include <cmath>
+#include <type_traits>
 
 namespace openrisk::crash {
 
@@ -15,36 +17,57 @@ struct LPPLParams {
     T phi;   // 相位偏移
 };
 
+/**
+ * @brief LPPL 模型
+ * 时间与价格序列以 T 存储；参数精度 P 可以更高 (float 数据 + double 参数)，残差在 accumulator_t 精度下累加
+ */
 template <core::FloatingPoint T = double>
 class LPPLModel {
 public:
     /**
      * @brief LPPL：log(P(t)) = A + B(tc-t)^m + C(tc-t)^m * cos(omega * log(tc-t) + phi)
      */
-    static T compute(T t, const LPPLParams<T>& p) {
-        T dt = p.tc - t;
+    template <core::FloatingPoint P = T>
+    static P compute(std::type_identity_t<P> t, const LPPLParams<P>& p) {
+        P dt = p.tc - t;
         if (dt <= 0) return p.A; // 已过临界点
 
-        T dt_m = std::pow(dt, p.m);
-        T log_dt = std::log(dt);
-        T oscillating_term = p.C * dt_m * std::cos(p.omega * log_dt + p.phi);
+        P dt_m = std::pow(dt, p.m);
+        P log_dt = std::log(dt);
+        P oscillating_term = p.C * dt_m * std::cos(p.omega * log_dt + p.phi);
         
         return p.A + p.B * dt_m + oscillating_term;
     }
 
     /**
      * @brief 计算拟合残差平方和
+     * 按固定大小的块在栈上缓冲区内向量化计算 log / exp / cos，不分配中间序列
      */
-    static T cost_function(const Eigen::VectorX<T>& t_series, 
-                           const Eigen::VectorX<T>& log_p_series, 
-                           const LPPLParams<T>& p) 
+    template <core::FloatingPoint P = T>
+    static P cost_function(core::ConstVectorRef<T> t_series, 
+                           core::ConstVectorRef<T> log_p_series, 
+                           const LPPLParams<P>& p) 
     {
-        T sse = 0.0;
-        for (int i = 0; i < t_series.size(); ++i) {
-            T pred = compute(t_series(i), p);
-            sse += std::pow(pred - log_p_series(i), 2);
+        using Acc = std::common_type_t<core::accumulator_t<T>, core::accumulator_t<P>>;
+        constexpr Eigen::Index block = 256;
+        const Eigen::Index n = t_series.size();
+
+        Eigen::Array<Acc, block, 1> dt;
+        Eigen::Array<Acc, block, 1> log_dt;
+        Eigen::Array<Acc, block, 1> pred;
+
+        Acc sse = 0.0;
+        for (Eigen::Index b = 0; b < n; b += block) {
+            const Eigen::Index len = std::min(block, n - b);
+            dt.head(len) = Acc(p.tc) - t_series.segment(b, len).template cast<Acc>().array();
+            // dt <= 0 (已过临界点) 时预测值为 A，先把 dt 替换为 1 避免 log 产生 NaN
+            log_dt.head(len) = (dt.head(len) > 0).select(dt.head(len), Acc(1)).log();
+            pred.head(len) = Acc(p.A) + (Acc(p.m) * log_dt.head(len)).exp() *
+                             (Acc(p.B) + Acc(p.C) * (Acc(p.omega) * log_dt.head(len) + Acc(p.phi)).cos());
+            pred.head(len) = (dt.head(len) > 0).select(pred.head(len), Acc(p.A));
+            sse += (pred.head(len) - log_p_series.segment(b, len).template cast<Acc>().array()).square().sum();
         }
-        return sse;
+        return static_cast<P>(sse);
     }
 
     /**
@@ -54,11 +77,31 @@ public:
         return (p.m > 0 && p.m < 1 && p.B < 0);
     }
 };
+/**
+ * @brief LPPL 标定选项
+ * 优化在 accumulator_t<T> 精度下进行，回调与遥测使用该精度；多起点时 stats 为各次运行之和。
+ *
+ * LBFGS 直接在 7 个参数上拟合。NelderMead / DifferentialEvolution 采用变量投影
+ * (Filimonov-Sornette)：线性参数 A、B、C cos(phi)、C sin(phi) 对给定的 (tc, m, omega)
+ * 用最小二乘闭式求解，优化器只搜索这 3 个非线性参数。
+ * 搜索前先在 (tc, m, omega) 粗网格上评估目标，NelderMead 从最好的 3 个网格点出发、
+ * DifferentialEvolution 从最好的 1 个出发；网格评估计入 stats.objective_evaluations。
+ */
+template <core::FloatingPoint T = double>
+struct LPPLCalibrationConfig {
+    core::OptimizerKind optimizer = core::OptimizerKind::LBFGS;
+    T max_horizon = 0.5;   // 变量投影时 tc 的搜索上界：t_last + max_horizon * 窗口长度
+    core::OptimizationObserver<core::accumulator_t<T>>* observer = nullptr; // 迭代回调
+    core::OptimizationStats<core::accumulator_t<T>>* stats = nullptr;       // 非空时写入优化器遥测
+    bool record_trajectory = false;                                          // 是否在 stats 中记录迭代轨迹
+};
+
 template <core::FloatingPoint T = double>
 class LPPLCalibrator {
 public:
-    static LPPLParams<T> calibrate(const Eigen::VectorX<T>& t_series, 
-                                   const Eigen::VectorX<T>& log_p_series,
-                                   T t_last);
+    static LPPLParams<T> calibrate(core::ConstVectorRef<T> t_series, 
+                                   core::ConstVectorRef<T> log_p_series,
+                                   T t_last,
+                                   const LPPLCalibrationConfig<T>& config = {});
 };
 } // namespace openrisk::crash
@@ -1,6 +1,7 @@
 #pragma once
 #include "../core/random.hpp"
 #include <cmath>
+#include <stdexcept>
 #include <boost/math/distributions/normal.hpp>
 #include <boost/math/distributions/students_t.hpp>
 
@@ -15,23 +16,40 @@ public:
      * @param n_samples 样本数量
      */
     static Eigen::MatrixX<T> generate_gaussian_samples(
-        const Eigen::MatrixX<T>& cholesky_l, 
+        core::ConstMatrixRef<T> cholesky_l, 
         std::size_t n_samples, 
         uint32_t seed = 42) 
     {
+        Eigen::MatrixX<T> samples(n_samples, cholesky_l.rows());
+        generate_gaussian_samples(cholesky_l, samples, seed);
+        return samples;
+    }
+
+    /**
+     * @brief 生成 Gaussian Copula 样本，写入调用方预先分配的 samples (n_samples x dims)
+     * @throws std::invalid_argument cholesky_l 非方阵或 samples 列数不等于维数
+     */
+    static void generate_gaussian_samples(
+        core::ConstMatrixRef<T> cholesky_l, 
+        core::MatrixRef<T> samples, 
+        uint32_t seed = 42) 
+    {
+        check_dimensions(cholesky_l, samples);
         core::RandomEngine<T> rng(seed);
-        std::size_t dims = cholesky_l.rows();
-        Eigen::MatrixX<T> samples(n_samples, dims);
+        const std::size_t n_samples = samples.rows();
+        const std::size_t dims = cholesky_l.rows();
+        Eigen::VectorX<T> e(dims);
+        Eigen::VectorX<T> z(dims);
         
         boost::math::normal_distribution<T> norm_dist(0, 1);
 
         for (std::size_t i = 0; i < n_samples; ++i) {
-            Eigen::VectorX<T> z = cholesky_l * rng.next_normal_vector(dims);
+            rng.fill_normal(e);
+            z.noalias() = cholesky_l * e;
             for (std::size_t j = 0; j < dims; ++j) {
                 samples(i, j) = boost::math::cdf(norm_dist, z(j));
             }
         }
-        return samples;
     }
 
     /**
@@ -41,27 +59,52 @@ public:
      * @param n_samples 样本数量
      */
     static Eigen::MatrixX<T> generate_t_samples(
-        const Eigen::MatrixX<T>& cholesky_l, 
+        core::ConstMatrixRef<T> cholesky_l, 
         T df, 
         std::size_t n_samples, 
         uint32_t seed = 42) 
     {
+        Eigen::MatrixX<T> samples(n_samples, cholesky_l.rows());
+        generate_t_samples(cholesky_l, df, samples, seed);
+        return samples;
+    }
+
+    /**
+     * @brief 生成 Student-t Copula 样本，写入调用方预先分配的 samples (n_samples x dims)
+     * @throws std::invalid_argument cholesky_l 非方阵或 samples 列数不等于维数
+     */
+    static void generate_t_samples(
+        core::ConstMatrixRef<T> cholesky_l, 
+        T df, 
+        core::MatrixRef<T> samples, 
+        uint32_t seed = 42) 
+    {
+        check_dimensions(cholesky_l, samples);
         core::RandomEngine<T> rng(seed);
-        std::size_t dims = cholesky_l.rows();
-        Eigen::MatrixX<T> samples(n_samples, dims);
+        const std::size_t n_samples = samples.rows();
+        const std::size_t dims = cholesky_l.rows();
+        Eigen::VectorX<T> e(dims);
+        Eigen::VectorX<T> z(dims);
         
         boost::math::students_t_distribution<T> t_dist(df);
         std::chi_squared_distribution<T> chi_sq(df);
         std::mt19937_64 engine(seed);
 
         for (std::size_t i = 0; i < n_samples; ++i) {
-            Eigen::VectorX<T> z = cholesky_l * rng.next_normal_vector(dims);
+            rng.fill_normal(e);
+            z.noalias() = cholesky_l * e;
             T w = std::sqrt(df / chi_sq(engine));
             for (std::size_t j = 0; j < dims; ++j) {
                 samples(i, j) = boost::math::cdf(t_dist, w * z(j));
             }
         }
-        return samples;
+    }
+
+private:
+    static void check_dimensions(core::ConstMatrixRef<T> cholesky_l, const core::MatrixRef<T>& samples) {
+        if (cholesky_l.rows() != cholesky_l.cols() || samples.cols() != cholesky_l.rows()) {
+            throw std::invalid_argument("Copula: samples must have one column per dimension of cholesky_l");
+        }
     }
 };
 
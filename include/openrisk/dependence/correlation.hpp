@@ -1,6 +1,7 @@
 #pragma once
 #include "../core/concepts.hpp"
 #include <algorithm>
+#include <stdexcept>
 #include <vector>
 
 namespace openrisk::dependence {
@@ -11,29 +12,34 @@ public:
     /**
      * @brief Pearson 线性相关系数
      */
-    static T pearson(const Eigen::VectorX<T>& x, const Eigen::VectorX<T>& y) {
-        T x_mean = x.mean();
-        T y_mean = y.mean();
-        auto x_centered = x.array() - x_mean;
-        auto y_centered = y.array() - y_mean;
+    static T pearson(core::ConstVectorRef<T> x, core::ConstVectorRef<T> y) {
+        using Acc = core::accumulator_t<T>;
+        Acc x_mean = x.template cast<Acc>().mean();
+        Acc y_mean = y.template cast<Acc>().mean();
+        auto x_centered = x.template cast<Acc>().array() - x_mean;
+        auto y_centered = y.template cast<Acc>().array() - y_mean;
         
-        T numerator = (x_centered * y_centered).sum();
-        T denominator = std::sqrt(x_centered.square().sum() * y_centered.square().sum());
+        Acc numerator = (x_centered * y_centered).sum();
+        Acc denominator = std::sqrt(x_centered.square().sum() * y_centered.square().sum());
         
-        return (denominator > 0) ? numerator / denominator : 0.0;
+        return (denominator > 0) ? static_cast<T>(numerator / denominator) : T(0);
     }
 
     /**
      * @brief Spearman 秩相关系数
      */
-    static T spearman(const Eigen::VectorX<T>& x, const Eigen::VectorX<T>& y) {
-        return pearson(rank_transform(x), rank_transform(y));
+    static T spearman(core::ConstVectorRef<T> x, core::ConstVectorRef<T> y) {
+        Eigen::VectorX<T> x_ranks(x.size());
+        Eigen::VectorX<T> y_ranks(y.size());
+        rank_transform(x, x_ranks);
+        rank_transform(y, y_ranks);
+        return pearson(x_ranks, y_ranks);
     }
 
     /**
      * @brief Kendall's Tau
      */
-    static T kendall_tau(const Eigen::VectorX<T>& x, const Eigen::VectorX<T>& y) {
+    static T kendall_tau(core::ConstVectorRef<T> x, core::ConstVectorRef<T> y) {
         std::size_t n = x.size();
         if (n < 2) return 0.0;
 
@@ -50,22 +56,26 @@ public:
                 else if (prod < 0) discordant++;
             }
         }
-        return static_cast<T>(concordant - discordant) / (0.5 * n * (n - 1));
+        return static_cast<T>((concordant - discordant) / (0.5 * n * (n - 1)));
     }
 
-private:
-    static Eigen::VectorX<T> rank_transform(const Eigen::VectorX<T>& vec) {
+    /**
+     * @brief 秩变换 (1..n)，结果写入调用方预先分配的 ranks
+     * @throws std::invalid_argument ranks 长度与 vec 不同
+     */
+    static void rank_transform(core::ConstVectorRef<T> vec, core::VectorRef<T> ranks) {
+        if (ranks.size() != vec.size()) {
+            throw std::invalid_argument("Correlation::rank_transform: ranks must have the same length as vec");
+        }
         std::size_t n = vec.size();
         std::vector<std::pair<T, std::size_t>> data(n);
         for (std::size_t i = 0; i < n; ++i) data[i] = {vec(i), i};
         
         std::sort(data.begin(), data.end());
         
-        Eigen::VectorX<T> ranks(n);
         for (std::size_t i = 0; i < n; ++i) {
             ranks(data[i].second) = static_cast<T>(i + 1);
         }
-        return ranks;
     }
 };
 
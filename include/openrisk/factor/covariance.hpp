@@ -1,5 +1,6 @@
 #pragma once
 #include "../core/stats.hpp"
+#include <stdexcept>
 
 namespace openrisk::factor {
 
@@ -9,29 +10,58 @@ public:
     /**
      * @brief 基础样本协方差矩阵
      */
-    static Eigen::MatrixX<T> sample_covariance(const Eigen::MatrixX<T>& returns) {
+    static Eigen::MatrixX<T> sample_covariance(core::ConstMatrixRef<T> returns) {
+        Eigen::MatrixX<T> cov(returns.cols(), returns.cols());
+        sample_covariance(returns, cov);
+        return cov;
+    }
+
+    /**
+     * @brief 样本协方差矩阵，结果写入调用方预先分配的 cov (p x p)
+     * @throws std::invalid_argument cov 不是 p x p (p 为 returns 的列数)
+     */
+    static void sample_covariance(core::ConstMatrixRef<T> returns, core::MatrixRef<T> cov) {
+        if (cov.rows() != returns.cols() || cov.cols() != returns.cols()) {
+            throw std::invalid_argument("CovarianceEstimator::sample_covariance: cov must be p x p");
+        }
+        using Acc = core::accumulator_t<T>;
         std::size_t n = returns.rows();
-        Eigen::MatrixX<T> centered = returns.rowwise() - returns.colwise().mean();
-        return (centered.adjoint() * centered) / static_cast<T>(n - 1);
+
+        if constexpr (std::is_same_v<Acc, T>) {
+            Eigen::MatrixX<T> centered = returns.rowwise() - returns.colwise().mean();
+            cov.noalias() = (centered.adjoint() * centered) / static_cast<T>(n - 1);
+        } else {
+            // 混合精度：按行块提升到累加精度，避免整块 double 副本使内存翻倍
+            const Eigen::Index block_rows = 4096;
+            Eigen::RowVectorX<Acc> mean = returns.template cast<Acc>().colwise().mean();
+            Eigen::MatrixX<Acc> acc = Eigen::MatrixX<Acc>::Zero(returns.cols(), returns.cols());
+            Eigen::MatrixX<Acc> centered;
+            for (Eigen::Index r = 0; r < returns.rows(); r += block_rows) {
+                const Eigen::Index rows = std::min(block_rows, returns.rows() - r);
+                centered = returns.middleRows(r, rows).template cast<Acc>().rowwise() - mean;
+                acc.noalias() += centered.adjoint() * centered;
+            }
+            cov = (acc / static_cast<Acc>(n - 1)).template cast<T>();
+        }
     }
 
     /**
      * @brief Ledoit-Wolf 收缩估算
      */
-    static Eigen::MatrixX<T> ledoit_wolf_shrinkage(const Eigen::MatrixX<T>& returns) {
+    static Eigen::MatrixX<T> ledoit_wolf_shrinkage(core::ConstMatrixRef<T> returns) {
         const std::size_t n = returns.rows(); // 样本数
         const std::size_t p = returns.cols(); // 资产数
         
         Eigen::MatrixX<T> sample_cov = sample_covariance(returns);
         
         T mean_var = sample_cov.diagonal().mean();
-        T sum_corr = 0.0;
+        core::accumulator_t<T> sum_corr = 0.0;
         for (std::size_t i = 0; i < p; ++i) {
             for (std::size_t j = i + 1; j < p; ++j) {
                 sum_corr += sample_cov(i, j) / std::sqrt(sample_cov(i, i) * sample_cov(j, j));
             }
         }
-        T average_corr = (p > 1) ? (2.0 * sum_corr / (p * (p - 1))) : 0.0;
+        T average_corr = (p > 1) ? static_cast<T>(2.0 * sum_corr / (p * (p - 1))) : T(0);
         
         Eigen::MatrixX<T> target = Eigen::MatrixX<T>::Constant(p, p, average_corr);
         for (std::size_t i = 0; i < p; ++i) {
@@ -46,17 +76,17 @@ public:
 
         T delta = estimate_shrinkage_intensity(returns, sample_cov, target);
         
-        return (1.0 - delta) * sample_cov + delta * target;
+        return (T(1) - delta) * sample_cov + delta * target;
     }
 
 private:
-    static T estimate_shrinkage_intensity(const Eigen::MatrixX<T>& returns, 
+    static T estimate_shrinkage_intensity(core::ConstMatrixRef<T> returns, 
                                          const Eigen::MatrixX<T>& S, 
                                          const Eigen::MatrixX<T>& F) {
         T p = static_cast<T>(returns.cols());
         T n = static_cast<T>(returns.rows());
         T ratio = p / n;
-        return std::clamp(ratio, 0.01, 0.99);
+        return std::clamp(ratio, T(0.01), T(0.99));
     }
 };
 
@@ -0,0 +1,244 @@
+#pragma once
+#include "../core/concepts.hpp"
+#include "../core/parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace openrisk::factor {
+
+/**
+ * @brief 稀疏调仓提案：assets[k] 的权重变化 deltas[k]
+ * 同一资产可以出现多次，其权重变化按顺序累加
+ */
+template <core::FloatingPoint T = double>
+struct TradeProposal {
+    std::vector<Eigen::Index> assets;
+    std::vector<T> deltas;
+};
+
+/**
+ * @brief 有状态的组合风险对象，用于盘前 what-if 检查
+ *
+ * 协方差结构为因子模型 Sigma = B F B^T + diag(D)。对象缓存因子暴露 e = B^T w、
+ * F e 以及 B F，从而：
+ *  - 调仓 / what-if 的组合方差更新为 O(K * |S|)，S 为变动资产集合；
+ *  - 单个资产的 MCTR 为 O(K)，(Sigma w)_i = B_i (F e) + D_i w_i。
+ * 增量更新会累积舍入误差，大量调仓后可调用 rebase() 从头重算。
+ */
+template <core::FloatingPoint T = double>
+class PortfolioRisk {
+public:
+    using RowMatrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    /**
+     * @param beta 因子暴露矩阵 (N x K)
+     * @param factor_cov 因子协方差矩阵 (K x K)，需对称
+     * @param specific_var 特异性风险向量 (N x 1)
+     * @param weights 当前资产权重 (N x 1)
+     */
+    PortfolioRisk(core::ConstMatrixRef<T> beta,
+                  core::ConstMatrixRef<T> factor_cov,
+                  core::ConstVectorRef<T> specific_var,
+                  core::ConstVectorRef<T> weights)
+        : beta_(beta),
+          factor_cov_(factor_cov),
+          specific_var_(specific_var),
+          weights_(weights) {
+        if (beta.cols() != factor_cov.rows() || factor_cov.rows() != factor_cov.cols() ||
+            specific_var.size() != beta.rows() || weights.size() != beta.rows()) {
+            throw std::invalid_argument("PortfolioRisk: inconsistent dimensions");
+        }
+        loaded_beta_ = beta * factor_cov;
+        rebase();
+    }
+
+    /**
+     * @brief 从头重算全部缓存量 O(N * K)
+     */
+    void rebase() {
+        exposure_ = beta_.transpose() * weights_;
+        factor_sigma_ = factor_cov_ * exposure_;
+        factor_var_ = exposure_.dot(factor_sigma_);
+        specific_risk_ = (weights_.array().square() * specific_var_.array()).sum();
+    }
+
+    T variance() const { return factor_var_ + specific_risk_; }
+    T volatility() const { return std::sqrt(variance()); }
+
+    const Eigen::VectorX<T>& weights() const { return weights_; }
+    const Eigen::VectorX<T>& exposure() const { return exposure_; }
+
+    /**
+     * @brief 单个资产的 MCTR = (Sigma w)_i / sigma_p，O(K)
+     */
+    T marginal_contribution(Eigen::Index i) const {
+        return covariance_times_weights(i) / volatility();
+    }
+
+    /**
+     * @brief 全部资产的 MCTR，O(N * K)
+     */
+    Eigen::VectorX<T> marginal_contribution_to_risk() const {
+        Eigen::VectorX<T> sigma_w = beta_ * factor_sigma_ + (specific_var_.array() * weights_.array()).matrix();
+        return sigma_w / volatility();
+    }
+
+    /**
+     * @brief 执行调仓并增量更新缓存，O(K * |S|)
+     * @throws std::invalid_argument assets 与 deltas 长度不一致
+     * @throws std::out_of_range 资产下标越界 (此时状态不变)
+     */
+    void apply(const TradeProposal<T>& trade) {
+        validate(trade);
+        const Eigen::Index k = exposure_.size();
+        for (std::size_t j = 0; j < trade.assets.size(); ++j) {
+            const Eigen::Index i = trade.assets[j];
+            const T dw = trade.deltas[j];
+            for (Eigen::Index f = 0; f < k; ++f) {
+                exposure_(f) += dw * beta_(i, f);
+                factor_sigma_(f) += dw * loaded_beta_(i, f);
+            }
+            specific_risk_ += specific_var_(i) * dw * (2 * weights_(i) + dw);
+            weights_(i) += dw;
+        }
+        factor_var_ = exposure_.dot(factor_sigma_);
+    }
+
+    /**
+     * @brief 在不修改状态的前提下计算调仓后的组合方差，O(K * |S|)
+     * K 不超过 kStackFactors 时中间量放在栈上，不分配堆内存。
+     * @throws std::invalid_argument assets 与 deltas 长度不一致
+     * @throws std::out_of_range 资产下标越界
+     */
+    T what_if_variance(const TradeProposal<T>& trade) const {
+        validate(trade);
+        const Eigen::Index k = exposure_.size();
+        if (k <= kStackFactors) {
+            T buffer[2 * kStackFactors];
+            Eigen::Map<Eigen::VectorX<T>> d_exposure(buffer, k);
+            Eigen::Map<Eigen::VectorX<T>> d_sigma(buffer + kStackFactors, k);
+            return what_if_variance_scratch(trade, d_exposure, d_sigma);
+        }
+        Eigen::VectorX<T> d_exposure(k);
+        Eigen::VectorX<T> d_sigma(k);
+        return what_if_variance_scratch(trade, d_exposure, d_sigma);
+    }
+
+    /**
+     * @brief 基于当前缓存状态并行评估一批候选调仓的组合方差
+     * 每次调用都会创建并回收线程；盘前检查这类反复调用的场景应使用接受 WorkerPool 的重载。
+     */
+    Eigen::VectorX<T> what_if_variance(const std::vector<TradeProposal<T>>& trades) const {
+        Eigen::VectorX<T> out(trades.size());
+        core::parallel_for(0, trades.size(), [&](std::size_t c) {
+            out(c) = what_if_variance(trades[c]);
+        }, kBatchChunk);
+        return out;
+    }
+
+    /**
+     * @brief 同上，在调用方持有的常驻线程池上评估，不创建线程
+     * 同一个 pool 同一时刻只能被一个调用使用。
+     */
+    Eigen::VectorX<T> what_if_variance(const std::vector<TradeProposal<T>>& trades, core::WorkerPool& pool) const {
+        Eigen::VectorX<T> out(trades.size());
+        pool.parallel_for(0, trades.size(), [&](std::size_t c) {
+            out(c) = what_if_variance(trades[c]);
+        }, kBatchChunk);
+        return out;
+    }
+
+    /**
+     * @brief what_if_variance 在栈上存放中间量的因子数上限
+     */
+    static constexpr Eigen::Index kStackFactors = 256;
+
+private:
+    static constexpr std::size_t kBatchChunk = 256; // 批量 what-if 每个线程至少处理的提案数
+
+    RowMatrix beta_;          // B，行主序以便 O(K) 读取单个资产
+    RowMatrix loaded_beta_;   // B F
+    Eigen::MatrixX<T> factor_cov_;
+    Eigen::VectorX<T> specific_var_;
+    Eigen::VectorX<T> weights_;
+
+    Eigen::VectorX<T> exposure_;     // e = B^T w
+    Eigen::VectorX<T> factor_sigma_; // F e
+    T factor_var_ = 0;               // e^T F e
+    T specific_risk_ = 0;            // sum D_i w_i^2
+
+    void validate(const TradeProposal<T>& trade) const {
+        if (trade.assets.size() != trade.deltas.size()) {
+            throw std::invalid_argument("PortfolioRisk: assets and deltas differ in length");
+        }
+        const Eigen::Index n = weights_.size();
+        for (Eigen::Index i : trade.assets) {
+            if (i < 0 || i >= n) {
+                throw std::out_of_range("PortfolioRisk: asset index out of range");
+            }
+        }
+    }
+
+    T what_if_variance_scratch(const TradeProposal<T>& trade, core::VectorRef<T> d_exposure, core::VectorRef<T> d_sigma) const {
+        const Eigen::Index k = exposure_.size();
+        d_exposure.setZero();
+        d_sigma.setZero();
+
+        for (std::size_t j = 0; j < trade.assets.size(); ++j) {
+            const Eigen::Index i = trade.assets[j];
+            const T dw = trade.deltas[j];
+            for (Eigen::Index f = 0; f < k; ++f) {
+                d_exposure(f) += dw * beta_(i, f);
+                d_sigma(f) += dw * loaded_beta_(i, f);
+            }
+        }
+
+        // (e + de)^T (Fe + F de)
+        T new_factor_var = factor_var_ + exposure_.dot(d_sigma) + d_exposure.dot(factor_sigma_) + d_exposure.dot(d_sigma);
+        return new_factor_var + specific_risk_ + specific_delta(trade);
+    }
+
+    /**
+     * @brief 特异性风险变化 sum_i D_i ((w_i + dw_i)^2 - w_i^2)
+     * 同一资产多次出现时，每次变化以此前已累加的权重为基准，与 apply() 的顺序执行一致。
+     * 小提案直接向前扫描，大提案按资产排序后分组，避免 O(|S|^2)。
+     */
+    T specific_delta(const TradeProposal<T>& trade) const {
+        constexpr std::size_t kScanLimit = 64;
+        const std::size_t s = trade.assets.size();
+        T d_specific = 0;
+
+        if (s <= kScanLimit) {
+            for (std::size_t j = 0; j < s; ++j) {
+                const Eigen::Index i = trade.assets[j];
+                T w = weights_(i);
+                for (std::size_t l = 0; l < j; ++l) {
+                    if (trade.assets[l] == i) w += trade.deltas[l];
+                }
+                d_specific += specific_var_(i) * trade.deltas[j] * (2 * w + trade.deltas[j]);
+            }
+            return d_specific;
+        }
+
+        std::vector<std::size_t> order(s);
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::stable_sort(order.begin(), order.end(),
+                         [&](std::size_t a, std::size_t b) { return trade.assets[a] < trade.assets[b]; });
+        for (std::size_t g = 0; g < s;) {
+            const Eigen::Index i = trade.assets[order[g]];
+            T dw = 0;
+            for (; g < s && trade.assets[order[g]] == i; ++g) dw += trade.deltas[order[g]];
+            d_specific += specific_var_(i) * dw * (2 * weights_(i) + dw);
+        }
+        return d_specific;
+    }
+
+    T covariance_times_weights(Eigen::Index i) const {
+        return beta_.row(i).dot(factor_sigma_) + specific_var_(i) * weights_(i);
+    }
+};
+
+} // namespace openrisk::factor
@@ -0,0 +1,239 @@
+#pragma once
+#include "../core/concepts.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace openrisk::io {
+
+/**
+ * @brief 列式行情文件格式 (.orc)
+ *
+ *   [timestamps: int64 x rows][column 0][column 1]...[directory][trailer]
+ *
+ * 每个数据块按 64 字节对齐，directory 为 ColumnInfo 数组，trailer 位于文件末尾
+ * (magic + 版本 + 行列数 + 各块偏移)。同类型相邻列之间的间距固定，因此一组列
+ * 可以直接映射为带 OuterStride 的列主序矩阵。
+ */
+enum class DataType : std::uint32_t {
+    Float64 = 1,
+    Float32 = 2,
+};
+
+template <core::FloatingPoint T>
+constexpr DataType data_type_of() {
+    static_assert(std::is_same_v<T, double> || std::is_same_v<T, float>,
+                  "columnar files store float64 / float32 only");
+    return std::is_same_v<T, double> ? DataType::Float64 : DataType::Float32;
+}
+
+struct ColumnInfo {
+    std::string name;
+    DataType type;
+    std::uint64_t offset; // 数据块在文件中的字节偏移
+};
+
+template <core::FloatingPoint T>
+using ColumnView = Eigen::Map<const Eigen::VectorX<T>>;
+
+template <core::FloatingPoint T>
+using ColumnBlockView = Eigen::Map<const Eigen::MatrixX<T>, Eigen::Unaligned, Eigen::OuterStride<>>;
+
+using TimestampView = Eigen::Map<const Eigen::VectorX<std::int64_t>>;
+
+/**
+ * @brief 顺序写入列式文件：构造时写入时间戳，随后逐列追加，close() 写入目录
+ */
+class ColumnarWriter {
+public:
+    ColumnarWriter(const std::string& path, const std::vector<std::int64_t>& timestamps);
+    ~ColumnarWriter();
+
+    ColumnarWriter(const ColumnarWriter&) = delete;
+    ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+
+    /**
+     * @brief 追加一列，元素类型取自 Derived::Scalar (float / double)
+     * 连续存储的向量直接写出；表达式或带步长的视图先求值到临时缓冲区。
+     */
+    template <typename Derived>
+        requires core::EigenVector<Derived> && core::FloatingPoint<typename Derived::Scalar>
+    void add_column(const std::string& name, const Eigen::MatrixBase<Derived>& values) {
+        using T = typename Derived::Scalar;
+        if (static_cast<std::uint64_t>(values.size()) != rows_) {
+            throw std::invalid_argument("ColumnarWriter: column '" + name + "' has wrong length");
+        }
+        const core::ConstVectorRef<T> contiguous(values);
+        write_column(name, data_type_of<T>(), contiguous.data(), rows_ * sizeof(T));
+    }
+
+    void close();
+
+private:
+    std::FILE* file_ = nullptr;
+    std::uint64_t rows_ = 0;
+    std::uint64_t position_ = 0;
+    std::uint64_t timestamps_offset_ = 0;
+    std::vector<ColumnInfo> columns_;
+
+    void write_column(const std::string& name, DataType type, const void* data, std::uint64_t bytes);
+    void write_block(const void* data, std::uint64_t bytes);
+    void pad_to_alignment();
+};
+
+class MappedColumnarFile;
+
+/**
+ * @brief 分块迭代时的一段行区间视图，所有访问均为零拷贝
+ */
+class ColumnarChunk {
+public:
+    std::size_t begin() const { return begin_; }
+    std::size_t rows() const { return rows_; }
+
+    TimestampView timestamps() const;
+
+    template <core::FloatingPoint T>
+    ColumnView<T> column(std::size_t index) const;
+
+    template <core::FloatingPoint T>
+    ColumnBlockView<T> columns(std::size_t first, std::size_t count) const;
+
+private:
+    friend class MappedColumnarFile;
+    ColumnarChunk(const MappedColumnarFile& file, std::size_t begin, std::size_t rows)
+        : file_(&file), begin_(begin), rows_(rows) {}
+
+    const MappedColumnarFile* file_;
+    std::size_t begin_;
+    std::size_t rows_;
+};
+
+/**
+ * @brief 只读内存映射列式文件
+ *
+ * column()/columns() 返回直接指向映射区域的 Eigen::Map，可直接传给接受
+ * core::ConstVectorRef / core::ConstMatrixRef 的接口 (calibrate_garch、
+ * LPPLCalibrator::calibrate、CovarianceEstimator、RiskMetrics 等) 而不拷贝。
+ * 视图的生命周期不得超过本对象。
+ */
+class MappedColumnarFile {
+public:
+    explicit MappedColumnarFile(const std::string& path);
+    ~MappedColumnarFile();
+
+    MappedColumnarFile(MappedColumnarFile&& other) noexcept;
+    MappedColumnarFile& operator=(MappedColumnarFile&& other) noexcept;
+    MappedColumnarFile(const MappedColumnarFile&) = delete;
+    MappedColumnarFile& operator=(const MappedColumnarFile&) = delete;
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return columns_.size(); }
+    const std::vector<ColumnInfo>& column_info() const { return columns_; }
+
+    /**
+     * @brief 按列名查找列下标，不存在时抛出 std::out_of_range
+     */
+    std::size_t column_index(std::string_view name) const;
+
+    TimestampView timestamps() const {
+        return TimestampView(reinterpret_cast<const std::int64_t*>(base_ + timestamps_offset_), rows_);
+    }
+
+    template <core::FloatingPoint T>
+    ColumnView<T> column(std::size_t index) const {
+        return ColumnView<T>(column_data<T>(index), rows_);
+    }
+
+    template <core::FloatingPoint T>
+    ColumnView<T> column(std::string_view name) const {
+        return column<T>(column_index(name));
+    }
+
+    /**
+     * @brief 将 [first, first + count) 列映射为 rows x count 的矩阵 (例如收益率面板)
+     * 要求这些列类型一致且在文件中连续存放 (ColumnarWriter 按顺序写入即满足)
+     */
+    template <core::FloatingPoint T>
+    ColumnBlockView<T> columns(std::size_t first, std::size_t count) const {
+        return ColumnBlockView<T>(column_data<T>(first), rows_, count, Eigen::OuterStride<>(block_stride<T>(first, count)));
+    }
+
+    /**
+     * @brief 按 chunk_rows 行分块顺序遍历，func(const ColumnarChunk&)
+     *
+     * 每块处理完后通知内核释放对应页面，常驻内存只与块大小相关，
+     * 可用于遍历大于物理内存的历史数据。
+     */
+    template <typename Func>
+    void for_each_chunk(std::size_t chunk_rows, Func&& func) const {
+        if (chunk_rows == 0) chunk_rows = rows_;
+        advise_sequential();
+        for (std::size_t begin = 0; begin < rows_; begin += chunk_rows) {
+            const std::size_t n = std::min(chunk_rows, rows_ - begin);
+            func(ColumnarChunk(*this, begin, n));
+            release_rows(begin, n);
+        }
+    }
+
+private:
+    friend class ColumnarChunk;
+
+    const unsigned char* base_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t rows_ = 0;
+    std::uint64_t timestamps_offset_ = 0;
+    std::vector<ColumnInfo> columns_;
+#ifdef _WIN32
+    void* file_handle_ = nullptr;
+    void* mapping_handle_ = nullptr;
+#endif
+
+    void unmap() noexcept;
+    void advise_sequential() const;
+    void release_rows(std::size_t begin, std::size_t rows) const;
+
+    template <core::FloatingPoint T>
+    const T* column_data(std::size_t index) const {
+        const ColumnInfo& info = columns_.at(index);
+        if (info.type != data_type_of<T>()) {
+            throw std::invalid_argument("MappedColumnarFile: column '" + info.name + "' has a different element type");
+        }
+        return reinterpret_cast<const T*>(base_ + info.offset);
+    }
+
+    template <core::FloatingPoint T>
+    Eigen::Index block_stride(std::size_t first, std::size_t count) const {
+        if (count <= 1) return static_cast<Eigen::Index>(rows_);
+        const std::uint64_t stride_bytes = columns_.at(first + 1).offset - columns_.at(first).offset;
+        for (std::size_t j = 1; j < count; ++j) {
+            const ColumnInfo& info = columns_.at(first + j);
+            if (info.type != data_type_of<T>() || info.offset != columns_[first].offset + j * stride_bytes) {
+                throw std::invalid_argument("MappedColumnarFile: columns are not a uniform contiguous block");
+            }
+        }
+        return static_cast<Eigen::Index>(stride_bytes / sizeof(T));
+    }
+};
+
+inline TimestampView ColumnarChunk::timestamps() const {
+    return TimestampView(file_->timestamps().data() + begin_, rows_);
+}
+
+template <core::FloatingPoint T>
+ColumnView<T> ColumnarChunk::column(std::size_t index) const {
+    return ColumnView<T>(file_->column_data<T>(index) + begin_, rows_);
+}
+
+template <core::FloatingPoint T>
+ColumnBlockView<T> ColumnarChunk::columns(std::size_t first, std::size_t count) const {
+    return ColumnBlockView<T>(file_->column_data<T>(first) + begin_, rows_, count,
+                              Eigen::OuterStride<>(file_->block_stride<T>(first, count)));
+}
+
+} // namespace openrisk::io
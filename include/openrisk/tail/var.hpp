@@ -1,6 +1,9 @@
 #pragma once
 #include "../core/stats.hpp"
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 
 namespace openrisk::tail {
 
@@ -10,35 +13,69 @@ public:
     /**
      * @brief 历史模拟法 Value at Risk
      */
-    static T historical_var(Eigen::VectorX<T> returns, T confidence_level = 0.95) {
-        std::sort(returns.data(), returns.data() + returns.size());
-        std::size_t index = static_cast<std::size_t>((1.0 - confidence_level) * returns.size());
-        return -returns(index);
+    static T historical_var(core::ConstVectorRef<T> returns, T confidence_level = 0.95) {
+        Eigen::VectorX<T> scratch;
+        return historical_var(returns, confidence_level, scratch);
+    }
+
+    /**
+     * @brief 历史模拟法 VaR，使用调用方提供的缓冲区 (尺寸一致时不再分配内存)
+     */
+    static T historical_var(core::ConstVectorRef<T> returns, T confidence_level, Eigen::VectorX<T>& scratch) {
+        scratch = returns;
+        std::size_t index = tail_count(confidence_level, scratch.size());
+        std::nth_element(scratch.data(), scratch.data() + index, scratch.data() + scratch.size());
+        return -scratch(index);
     }
 
     /**
      * @brief 参数法 Value at Risk (正态分布假设)
      */
-    static T parametric_var(const Eigen::VectorX<T>& returns, T confidence_level = 0.95) {
+    static T parametric_var(core::ConstVectorRef<T> returns, T confidence_level = 0.95) {
         T sigma = core::Statistics<T>::standard_deviation(returns);
         T mean = core::Statistics<T>::mean(returns);
         
-        T z_score = (confidence_level > 0.97) ? 2.326 : 1.645; 
+        T z_score = (confidence_level > 0.97) ? T(2.326) : T(1.645); 
         return -(mean - z_score * sigma);
     }
 
     /**
      * @brief Expected Shortfall (CVaR)
      */
-    static T expected_shortfall(Eigen::VectorX<T> returns, T confidence_level = 0.95) {
-        std::sort(returns.data(), returns.data() + returns.size());
-        std::size_t cutoff = static_cast<std::size_t>((1.0 - confidence_level) * returns.size());
+    static T expected_shortfall(core::ConstVectorRef<T> returns, T confidence_level = 0.95) {
+        Eigen::VectorX<T> scratch;
+        return expected_shortfall(returns, confidence_level, scratch);
+    }
+
+    /**
+     * @brief Expected Shortfall，使用调用方提供的缓冲区 (尺寸一致时不再分配内存)
+     */
+    static T expected_shortfall(core::ConstVectorRef<T> returns, T confidence_level, Eigen::VectorX<T>& scratch) {
+        scratch = returns;
+        std::size_t cutoff = tail_count(confidence_level, scratch.size());
+        // 只需要最小的 cutoff 个收益率，无需整体排序
+        std::nth_element(scratch.data(), scratch.data() + cutoff, scratch.data() + scratch.size());
         
-        T sum = 0.0;
-        for (std::size_t i = 0; i < cutoff; ++i) {
-            sum += returns(i);
-        }
-        return -(sum / static_cast<T>(cutoff));
+        core::accumulator_t<T> sum = scratch.head(cutoff).template cast<core::accumulator_t<T>>().sum();
+        return static_cast<T>(-(sum / static_cast<core::accumulator_t<T>>(cutoff)));
+    }
+
+private:
+    /**
+     * @brief 尾部样本个数 floor((1 - c) * n)
+     * 0.95f 这类置信度无法精确表示，其误差乘以 n 后会让结果多一个或少一个。先把 1 - c 舍入到 T 能区分的
+     * 十进制位数 (float 6 位，double 取 9 位)，再用整数运算计算 floor(units * n / 10^digits)。
+     */
+    static std::size_t tail_count(T confidence_level, std::size_t n) {
+        constexpr int digits = std::min(std::numeric_limits<T>::digits10, 9);
+        std::uint64_t scale = 1;
+        for (int i = 0; i < digits; ++i) scale *= 10;
+        const double tail = std::clamp(1.0 - static_cast<double>(confidence_level), 0.0, 1.0);
+        const auto units = static_cast<std::uint64_t>(std::llround(tail * static_cast<double>(scale)));
+        // 拆成 n = q * scale + r，避免 units * n 溢出
+        const std::uint64_t q = n / scale;
+        const std::uint64_t r = n % scale;
+        return static_cast<std::size_t>(q * units + r * units / scale);
     }
 };
 
@@ -1,58 +1,286 @@
 #pragma once
-#include "../core/concepts.hpp"
+#include "../core/optimization.hpp"
+#include "../core/parallel.hpp"
+#include <boost/math/special_functions/gamma.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 namespace openrisk::time_series {
 
+/**
+ * @brief 条件方差递推形式
+ */
+enum class GarchVariant {
+    Symmetric, // sigma^2_t = omega + alpha r^2 + beta sigma^2
+    GJR,       // sigma^2_t = omega + (alpha + gamma 1{r < 0}) r^2 + beta sigma^2
+    EGARCH,    // ln sigma^2_t = omega + alpha (|z| - E|z|) + gamma z + beta ln sigma^2，z = r / sigma
+};
+
+/**
+ * @brief 标准化新息分布
+ */
+enum class Innovation {
+    Gaussian,
+    StudentT, // 单位方差 Student-t，自由度 nu > 2
+};
+
 template <core::FloatingPoint T = double>
 struct GarchParams {
-    T omega; // 常数
-    T alpha; // ARCH
-    T beta;  // GARCH
+    T omega;     // 常数
+    T alpha;     // ARCH
+    T beta;      // GARCH
+    T gamma = 0; // 杠杆项 (GJR / EGARCH)
+    T nu = 0;    // 自由度 (Student-t 新息)
 };
 
-template <core::FloatingPoint T = double>
+/**
+ * @brief GARCH 族共享的递推核
+ * 按 (variant, innovation) 在编译期特化：单步递推与块内对数密度都由 if constexpr 展开，
+ * 内层循环中没有虚函数调用或运行期分派。参数在构造时转换为计算精度 Acc，
+ * 与分布相关的常数 (Student-t 归一化常数、EGARCH 的 E|z|) 也只在构造时计算一次。
+ */
+template <GarchVariant V, Innovation I, core::FloatingPoint Acc>
+struct GarchKernel {
+    Acc omega;
+    Acc alpha;
+    Acc beta;
+    Acc gamma;
+    Acc nu = 0;
+    Acc abs_mean = 0;     // E|z|，仅 EGARCH 使用
+    Acc log_constant = 0; // 单个观测对数密度中与 sigma^2 无关的常数项
+
+    template <core::FloatingPoint P>
+    explicit GarchKernel(const GarchParams<P>& params)
+        : omega(params.omega), alpha(params.alpha), beta(params.beta), gamma(params.gamma) {
+        const Acc pi = std::numbers::pi_v<Acc>;
+        if constexpr (I == Innovation::Gaussian) {
+            log_constant = -Acc(0.5) * std::log(2 * pi);
+            if constexpr (V == GarchVariant::EGARCH) abs_mean = std::sqrt(2 / pi);
+        } else {
+            nu = params.nu;
+            const Acc log_gamma_ratio = boost::math::lgamma((nu + 1) / 2) - boost::math::lgamma(nu / 2);
+            log_constant = log_gamma_ratio - Acc(0.5) * std::log(pi * (nu - 2));
+            if constexpr (V == GarchVariant::EGARCH) {
+                abs_mean = 2 * std::sqrt(nu - 2) / (nu - 1) * std::exp(log_gamma_ratio) / std::sqrt(pi);
+            }
+        }
+    }
+
+    /**
+     * @brief 递推状态与方差互转：EGARCH 的状态为 ln sigma^2，其余变体即 sigma^2
+     */
+    Acc to_state(Acc sigma_sq) const {
+        if constexpr (V == GarchVariant::EGARCH) return std::log(sigma_sq);
+        else return sigma_sq;
+    }
+
+    Acc to_variance(Acc state) const {
+        if constexpr (V == GarchVariant::EGARCH) return std::exp(state);
+        else return state;
+    }
+
+    /**
+     * @brief 由 t-1 时刻的状态与 r_{t-1} 计算 t 时刻的状态
+     * EGARCH 在对数空间递推，每步只需一次 exp 求 z
+     */
+    Acc next(Acc state, Acc r) const {
+        if constexpr (V == GarchVariant::Symmetric) {
+            return omega + alpha * r * r + beta * state;
+        } else if constexpr (V == GarchVariant::GJR) {
+            const Acc arch = r < 0 ? alpha + gamma : alpha;
+            return omega + arch * r * r + beta * state;
+        } else {
+            const Acc z = r * std::exp(-state / 2);
+            return omega + alpha * (std::abs(z) - abs_mean) + gamma * z + beta * state;
+        }
+    }
+
+    /**
+     * @brief 一个块内的对数密度之和 (不含 log_constant)，log sigma^2 与 r^2 / sigma^2 在块内向量化计算
+     */
+    template <typename RSq, typename States>
+    Acc log_density_sum(const RSq& r_sq, const States& states) const {
+        auto log_var = [&] {
+            if constexpr (V == GarchVariant::EGARCH) return states;
+            else return states.log();
+        }();
+        auto standardized_sq = [&] {
+            if constexpr (V == GarchVariant::EGARCH) return r_sq * (-states).exp();
+            else return r_sq / states;
+        }();
+        if constexpr (I == Innovation::Gaussian) {
+            return -Acc(0.5) * (log_var + standardized_sq).sum();
+        } else {
+            const Acc scale = 1 / (nu - 2);
+            return -(Acc(0.5) * log_var + (nu + 1) / 2 * (scale * standardized_sq).log1p()).sum();
+        }
+    }
+};
+
+/**
+ * @brief GARCH(1,1) 族模型
+ * 收益率以 T 存储，方差递推与似然累加在 accumulator_t<T> 精度下进行 (float 数据用 double 累加)。
+ * V 与 I 选择方差递推与新息分布，默认即对称 GARCH + 正态新息。
+ */
+template <core::FloatingPoint T = double,
+          GarchVariant V = GarchVariant::Symmetric,
+          Innovation I = Innovation::Gaussian>
 class GarchModel {
 public:
+    using Accumulator = core::accumulator_t<T>;
+    using Kernel = GarchKernel<V, I, Accumulator>;
+
     /**
      * @brief 波动率过滤：根据给定参数计算时序波动率 sigma_t
      * @param returns 收益率序列 (已去均值)
      * @param params 模型参数
      * @return 预测的波动率序列 (sigma^2)
      */
-    static Eigen::VectorX<T> filter(const Eigen::VectorX<T>& returns, const GarchParams<T>& params) {
+    static Eigen::VectorX<T> filter(core::ConstVectorRef<T> returns, const GarchParams<T>& params) {
+        Eigen::VectorX<T> sigmas_sq(returns.size());
+        filter(returns, params, sigmas_sq);
+        return sigmas_sq;
+    }
+
+    /**
+     * @brief 波动率过滤，结果写入调用方预先分配的 sigmas_sq (长度与 returns 相同)
+     * @throws std::invalid_argument sigmas_sq 长度与 returns 不同
+     */
+    static void filter(core::ConstVectorRef<T> returns, const GarchParams<T>& params, core::VectorRef<T> sigmas_sq) {
+        if (sigmas_sq.size() != returns.size()) {
+            throw std::invalid_argument("GarchModel::filter: sigmas_sq must have the same length as returns");
+        }
         const std::size_t n = returns.size();
-        Eigen::VectorX<T> sigmas_sq(n);
-        
-        T initial_variance = (returns.array().square().sum()) / static_cast<T>(n);
-        sigmas_sq(0) = initial_variance;
+        if (n == 0) return;
+        const Kernel kernel(params);
+
+        Accumulator state = kernel.to_state(
+            returns.template cast<Accumulator>().array().square().sum() / static_cast<Accumulator>(n));
+        sigmas_sq(0) = static_cast<T>(kernel.to_variance(state));
 
         for (std::size_t t = 1; t < n; ++t) {
-            sigmas_sq(t) = params.omega + 
-                           params.alpha * std::pow(returns(t-1), 2) + 
-                           params.beta * sigmas_sq(t-1);
+            state = kernel.next(state, returns(t-1));
+            sigmas_sq(t) = static_cast<T>(kernel.to_variance(state));
         }
-        return sigmas_sq;
     }
 
     /**
      * @brief 计算负对数似然
-     * 用于优化器寻找最优参数
+     * 用于优化器寻找最优参数。参数精度 P 可以高于数据精度 T (float 数据 + double 参数)。
+     * 递推按块写入栈上缓冲区，对数密度在块内向量化求和，不分配中间序列。
      */
-    static T log_likelihood(const Eigen::VectorX<T>& returns, const GarchParams<T>& params) {
-        const std::size_t n = returns.size();
-        Eigen::VectorX<T> sigmas_sq = filter(returns, params);
-        
-        T log_lik = 0.0;
-        const T pi = std::numbers::pi_v<T>;
+    template <core::FloatingPoint P = T>
+    static P log_likelihood(core::ConstVectorRef<T> returns, const GarchParams<P>& params) {
+        using Acc = std::common_type_t<Accumulator, core::accumulator_t<P>>;
+        constexpr Eigen::Index block = 256;
+        const Eigen::Index n = returns.size();
+        const GarchKernel<V, I, Acc> kernel(params);
+
+        Eigen::Array<Acc, block, 1> r;
+        Eigen::Array<Acc, block, 1> states;
+
+        Acc state = kernel.to_state(returns.template cast<Acc>().array().square().sum() / static_cast<Acc>(n));
+        Acc prev_r = 0;
+        Acc sum = 0;
+        for (Eigen::Index b = 0; b < n; b += block) {
+            const Eigen::Index len = std::min(block, n - b);
+            r.head(len) = returns.segment(b, len).template cast<Acc>().array();
+            for (Eigen::Index i = 0; i < len; ++i) {
+                if (b + i > 0) {
+                    state = kernel.next(state, prev_r);
+                }
+                states(i) = state;
+                prev_r = r(i);
+            }
+            sum += kernel.log_density_sum(r.head(len).square(), states.head(len));
+        }
+
+        Acc log_lik = static_cast<Acc>(n) * kernel.log_constant + sum;
+        return static_cast<P>(-log_lik);
+    }
+
+    /**
+     * @brief 对收益率面板 (T x N，每列一个资产) 逐列过滤，各列在多个线程上并行
+     * @param params 每个资产一组参数，长度须等于列数
+     * @param sigmas_sq 输出，形状与 returns 相同
+     * @param max_threads 线程数上限，0 表示使用全部硬件线程
+     */
+    static void filter_panel(core::ConstMatrixRef<T> returns, const std::vector<GarchParams<T>>& params,
+                             core::MatrixRef<T> sigmas_sq, std::size_t max_threads = 0) {
+        if (params.size() != static_cast<std::size_t>(returns.cols()) ||
+            sigmas_sq.rows() != returns.rows() || sigmas_sq.cols() != returns.cols()) {
+            throw std::invalid_argument("GarchModel::filter_panel: inconsistent dimensions");
+        }
+        core::parallel_for(0, params.size(), [&](std::size_t j) {
+            filter(returns.col(j), params[j], sigmas_sq.col(j));
+        }, 1, max_threads);
+    }
 
-        for (std::size_t t = 0; t < n; ++t) {
-            // 假设正态分布：-0.5 * (log(2*pi) + log(sigma^2) + r^2/sigma^2)
-            log_lik += -0.5 * (std::log(2 * pi) + std::log(sigmas_sq(t)) + std::pow(returns(t), 2) / sigmas_sq(t));
+    static Eigen::MatrixX<T> filter_panel(core::ConstMatrixRef<T> returns, const std::vector<GarchParams<T>>& params,
+                                          std::size_t max_threads = 0) {
+        Eigen::MatrixX<T> sigmas_sq(returns.rows(), returns.cols());
+        filter_panel(returns, params, sigmas_sq, max_threads);
+        return sigmas_sq;
+    }
+
+    /**
+     * @brief 面板各列的负对数似然，各列在多个线程上并行
+     */
+    static Eigen::VectorX<T> log_likelihood_panel(core::ConstMatrixRef<T> returns, const std::vector<GarchParams<T>>& params,
+                                                  std::size_t max_threads = 0) {
+        if (params.size() != static_cast<std::size_t>(returns.cols())) {
+            throw std::invalid_argument("GarchModel::log_likelihood_panel: inconsistent dimensions");
         }
-        return -log_lik;
+        Eigen::VectorX<T> out(returns.cols());
+        core::parallel_for(0, params.size(), [&](std::size_t j) {
+            out(j) = log_likelihood(returns.col(j), params[j]);
+        }, 1, max_threads);
+        return out;
     }
 };
+
+template <core::FloatingPoint T = double>
+using GjrGarchModel = GarchModel<T, GarchVariant::GJR>;
+
+template <core::FloatingPoint T = double>
+using EGarchModel = GarchModel<T, GarchVariant::EGARCH>;
+
+/**
+ * @brief GARCH 标定选项
+ * 优化在 accumulator_t<T> 精度下进行，回调与遥测使用该精度
+ * LBFGS 未满足收敛判据时 (常见于有限差分梯度跨过平稳性约束)，自动以 Nelder-Mead 从其最好点继续，
+ * stats 为两次运行之和。结果是否收敛通过 stats->unconverged_runs 报告：非零表示最终的优化器在满足
+ * 收敛判据前停止，返回的是迄今最好的点而非极值点。
+ */
+template <core::FloatingPoint T = double>
+struct GarchCalibrationConfig {
+    GarchVariant variant = GarchVariant::Symmetric;
+    Innovation innovation = Innovation::Gaussian;
+    core::OptimizerKind optimizer = core::OptimizerKind::LBFGS;
+    std::size_t optimizer_threads = 0;                                       // 差分进化的线程数，0 表示硬件并发数
+    core::OptimizationObserver<core::accumulator_t<T>>* observer = nullptr; // 迭代回调
+    core::OptimizationStats<core::accumulator_t<T>>* stats = nullptr;       // 非空时写入优化器遥测
+    bool record_trajectory = false;                                          // 是否在 stats 中记录迭代轨迹
+};
+
+/**
+ * @brief 按 config.variant / config.innovation 标定单个资产
+ * 运行期选项只在入口处分派一次，之后进入对应的编译期特化实现
+ */
+template <core::FloatingPoint T = double>
+GarchParams<T> calibrate_garch(core::ConstVectorRef<T> returns, const GarchCalibrationConfig<T>& config = {});
+
+/**
+ * @brief 逐列标定收益率面板 (T x N)，各列在多个线程上并行
+ * observer 不会被调用 (回调不要求线程安全)；stats 非空时写入所有列遥测之和。
+ * 并行只发生在列之间：各列的差分进化固定单线程评估种群，不会与外层嵌套开线程。
+ */
 template <core::FloatingPoint T = double>
-GarchParams<T> calibrate_garch(const Eigen::VectorX<T>& returns);
+std::vector<GarchParams<T>> calibrate_garch_panel(core::ConstMatrixRef<T> returns,
+                                                  const GarchCalibrationConfig<T>& config = {},
+                                                  std::size_t max_threads = 0);
 } // namespace openrisk::time_series
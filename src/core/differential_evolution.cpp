@@ -0,0 +1,113 @@
+#include "openrisk/core/differential_evolution.hpp"
+#include "openrisk/core/parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace openrisk::core {
+
+template <FloatingPoint T>
+OptimizationResult<T> DifferentialEvolutionOptimizer<T>::minimize(
+    ObjectiveFunc<T> func, const Eigen::VectorX<T>& x0,
+    const Eigen::VectorX<T>& lower_bounds, const Eigen::VectorX<T>& upper_bounds) {
+
+    OptimizationResult<T> res;
+    OptimizationStats<T>& stats = res.stats;
+    const Eigen::Index n = x0.size();
+    const std::size_t np = config_.population > 0
+        ? static_cast<std::size_t>(config_.population)
+        : static_cast<std::size_t>(std::max<Eigen::Index>(20, 10 * n));
+
+    if (n == 0) {
+        res.x_best = x0;
+        res.min_value = func(x0);
+        if constexpr (telemetry_enabled) ++stats.objective_evaluations;
+        res.converged = true;
+        return res;
+    }
+
+    Eigen::VectorX<T> lb = lower_bounds;
+    Eigen::VectorX<T> ub = upper_bounds;
+    if (lb.size() != n || ub.size() != n) {
+        Eigen::VectorX<T> radius = x0.cwiseAbs().array() + T(1);
+        lb = x0 - radius;
+        ub = x0 + radius;
+    }
+
+    std::mt19937_64 engine(config_.seed);
+    std::uniform_real_distribution<T> uniform(0.0, 1.0);
+    std::uniform_int_distribution<std::size_t> pick(0, np - 1);
+    std::uniform_int_distribution<Eigen::Index> pick_dim(0, n - 1);
+
+    // 种群：第 0 个个体为 x0，其余在边界内均匀采样
+    std::vector<Eigen::VectorX<T>> population(np, x0.cwiseMax(lb).cwiseMin(ub));
+    for (std::size_t i = 1; i < np; ++i) {
+        for (Eigen::Index j = 0; j < n; ++j) {
+            population[i](j) = lb(j) + uniform(engine) * (ub(j) - lb(j));
+        }
+    }
+
+    std::vector<T> values(np);
+    WorkerPool pool(config_.threads);
+    auto evaluate_all = [&](const std::vector<Eigen::VectorX<T>>& xs, std::vector<T>& out) {
+        pool.parallel_for(0, np, [&](std::size_t i) { out[i] = func(xs[i]); });
+        if constexpr (telemetry_enabled) stats.objective_evaluations += static_cast<long>(np);
+    };
+    evaluate_all(population, values);
+
+    std::vector<Eigen::VectorX<T>> trials(np, Eigen::VectorX<T>(n));
+    std::vector<T> trial_values(np);
+
+    for (int gen = 0; gen < config_.max_generations; ++gen) {
+        // 变异与交叉在主线程按固定顺序抽样，保证结果与线程数无关
+        for (std::size_t i = 0; i < np; ++i) {
+            std::size_t r1, r2, r3;
+            do { r1 = pick(engine); } while (r1 == i);
+            do { r2 = pick(engine); } while (r2 == i || r2 == r1);
+            do { r3 = pick(engine); } while (r3 == i || r3 == r1 || r3 == r2);
+            const Eigen::Index j_rand = pick_dim(engine);
+
+            for (Eigen::Index j = 0; j < n; ++j) {
+                if (j == j_rand || uniform(engine) < config_.crossover) {
+                    T v = population[r1](j) + config_.mutation * (population[r2](j) - population[r3](j));
+                    // 越界时取父代与边界的中点
+                    if (v < lb(j)) v = (lb(j) + population[i](j)) / 2;
+                    if (v > ub(j)) v = (ub(j) + population[i](j)) / 2;
+                    trials[i](j) = v;
+                } else {
+                    trials[i](j) = population[i](j);
+                }
+            }
+        }
+
+        evaluate_all(trials, trial_values);
+
+        for (std::size_t i = 0; i < np; ++i) {
+            if (trial_values[i] <= values[i]) {
+                std::swap(population[i], trials[i]);
+                values[i] = trial_values[i];
+            }
+        }
+
+        const auto [lo, hi] = std::minmax_element(values.begin(), values.end());
+        const T spread = *hi - *lo;
+        res.iterations = gen + 1;
+        if (!this->notify_iteration(stats, {gen, *lo, T(0), spread})) break;
+        if (spread <= config_.f_tol) {
+            res.converged = true;
+            break;
+        }
+    }
+
+    const std::size_t best = std::min_element(values.begin(), values.end()) - values.begin();
+    res.x_best = population[best];
+    res.min_value = values[best];
+    stats.unconverged_runs = res.converged ? 0 : 1;
+    return res;
+}
+
+template class DifferentialEvolutionOptimizer<double>;
+template class DifferentialEvolutionOptimizer<float>;
+
+} // namespace openrisk::core
@@ -0,0 +1,118 @@
+#include "openrisk/core/nelder_mead.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace openrisk::core {
+
+template <FloatingPoint T>
+OptimizationResult<T> NelderMeadOptimizer<T>::minimize(
+    ObjectiveFunc<T> func, const Eigen::VectorX<T>& x0,
+    const Eigen::VectorX<T>& lb, const Eigen::VectorX<T>& ub) {
+
+    OptimizationResult<T> res;
+    OptimizationStats<T>& stats = res.stats;
+    const Eigen::Index n = x0.size();
+    const bool bounded = lb.size() == n && ub.size() == n;
+
+    if (n == 0) {
+        res.x_best = x0;
+        res.min_value = func(x0);
+        if constexpr (telemetry_enabled) ++stats.objective_evaluations;
+        res.converged = true;
+        return res;
+    }
+
+    auto evaluate = [&](Eigen::VectorX<T>& x) -> T {
+        if (bounded) x = x.cwiseMax(lb).cwiseMin(ub);
+        if constexpr (telemetry_enabled) ++stats.objective_evaluations;
+        return func(x);
+    };
+
+    // 初始单纯形：x0 及沿各坐标轴偏移 initial_step 比例的 n 个顶点
+    std::vector<Eigen::VectorX<T>> simplex(n + 1, x0);
+    std::vector<T> values(n + 1);
+    values[0] = evaluate(simplex[0]);
+    for (Eigen::Index i = 0; i < n; ++i) {
+        T step = config_.initial_step * std::abs(x0(i));
+        if (step == 0) step = static_cast<T>(0.00025);
+        simplex[i + 1](i) += step;
+        values[i + 1] = evaluate(simplex[i + 1]);
+    }
+
+    std::vector<std::size_t> order(n + 1);
+    Eigen::VectorX<T> centroid(n);
+
+    for (int iter = 0; iter < config_.max_iter; ++iter) {
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return values[a] < values[b]; });
+        const std::size_t best = order.front();
+        const std::size_t worst = order.back();
+        const std::size_t second_worst = order[n - 1];
+
+        T diameter = 0;
+        for (std::size_t i = 0; i <= static_cast<std::size_t>(n); ++i) {
+            diameter = std::max(diameter, (simplex[i] - simplex[best]).template lpNorm<Eigen::Infinity>());
+        }
+        if (std::abs(values[worst] - values[best]) <= config_.f_tol && diameter <= config_.x_tol) {
+            res.converged = true;
+            break;
+        }
+
+        centroid.setZero();
+        for (std::size_t i = 0; i <= static_cast<std::size_t>(n); ++i) {
+            if (i != worst) centroid += simplex[i];
+        }
+        centroid /= static_cast<T>(n);
+
+        Eigen::VectorX<T> reflected = centroid + config_.reflection * (centroid - simplex[worst]);
+        T f_reflected = evaluate(reflected);
+
+        if (f_reflected < values[best]) {
+            Eigen::VectorX<T> expanded = centroid + config_.expansion * (reflected - centroid);
+            T f_expanded = evaluate(expanded);
+            if (f_expanded < f_reflected) {
+                simplex[worst] = std::move(expanded);
+                values[worst] = f_expanded;
+            } else {
+                simplex[worst] = std::move(reflected);
+                values[worst] = f_reflected;
+            }
+        } else if (f_reflected < values[second_worst]) {
+            simplex[worst] = std::move(reflected);
+            values[worst] = f_reflected;
+        } else {
+            // 外收缩 (反射点优于最差点) 或内收缩
+            const bool outside = f_reflected < values[worst];
+            Eigen::VectorX<T> contracted = outside
+                ? Eigen::VectorX<T>(centroid + config_.contraction * (reflected - centroid))
+                : Eigen::VectorX<T>(centroid + config_.contraction * (simplex[worst] - centroid));
+            T f_contracted = evaluate(contracted);
+            if (f_contracted < (outside ? f_reflected : values[worst])) {
+                simplex[worst] = std::move(contracted);
+                values[worst] = f_contracted;
+            } else {
+                for (std::size_t i = 0; i <= static_cast<std::size_t>(n); ++i) {
+                    if (i == best) continue;
+                    simplex[i] = simplex[best] + config_.shrink * (simplex[i] - simplex[best]);
+                    values[i] = evaluate(simplex[i]);
+                }
+            }
+        }
+
+        res.iterations = iter + 1;
+        const std::size_t current_best = std::min_element(values.begin(), values.end()) - values.begin();
+        if (!this->notify_iteration(stats, {iter, values[current_best], T(0), diameter})) break;
+    }
+
+    const std::size_t best = std::min_element(values.begin(), values.end()) - values.begin();
+    res.x_best = simplex[best];
+    res.min_value = values[best];
+    stats.unconverged_runs = res.converged ? 0 : 1;
+    return res;
+}
+
+template class NelderMeadOptimizer<double>;
+template class NelderMeadOptimizer<float>;
+
+} // namespace openrisk::core
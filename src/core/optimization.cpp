@@ -1,18 +1,27 @@
 #include "openrisk/core/lbfgs.hpp"
+#include "openrisk/core/differential_evolution.hpp"
+#include "openrisk/core/nelder_mead.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 namespace openrisk::core {
 
 template <FloatingPoint T>
-Eigen::VectorX<T> LBFGSOptimizer<T>::estimate_gradient(ObjectiveFunc<T> func, const Eigen::VectorX<T>& x) {
+Eigen::VectorX<T> LBFGSOptimizer<T>::estimate_gradient(const ObjectiveFunc<T>& func, const Eigen::VectorX<T>& x, OptimizationStats<T>& stats) {
+    ScopedTimer timer(stats.gradient_seconds);
+    if constexpr (telemetry_enabled) ++stats.gradient_evaluations;
+
     Eigen::VectorX<T> g = Eigen::VectorX<T>::Zero(x.size());
-    const T h = 1e-7;
+    // float 下 1e-7 的扰动低于机器精度，改用 eps^(1/3) (中心差分的最优步长量级)
+    const T h = std::is_same_v<T, float> ? std::cbrt(std::numeric_limits<T>::epsilon()) : static_cast<T>(1e-7);
     for (int i = 0; i < x.size(); ++i) {
         Eigen::VectorX<T> x_plus = x;
         Eigen::VectorX<T> x_minus = x;
         x_plus(i) += h;
         x_minus(i) -= h;
-        g(i) = (func(x_plus) - func(x_minus)) / (2.0 * h);
+        g(i) = (func(x_plus) - func(x_minus)) / (2 * h);
     }
     return g;
 }
@@ -42,18 +51,25 @@ Eigen::VectorX<T> LBFGSOptimizer<T>::compute_direction(const Eigen::VectorX<T>&
 }
 
 template <FloatingPoint T>
-T LBFGSOptimizer<T>::line_search(ObjectiveFunc<T> func, const Eigen::VectorX<T>& x, const Eigen::VectorX<T>& g, const Eigen::VectorX<T>& d, T step) {
+T LBFGSOptimizer<T>::line_search(const ObjectiveFunc<T>& func, const Eigen::VectorX<T>& x, T phi_0,
+                                 const Eigen::VectorX<T>& g, const Eigen::VectorX<T>& d, T step,
+                                 T& phi_step, OptimizationStats<T>& stats) {
+    ScopedTimer timer(stats.line_search_seconds);
     const T c1 = config_.wolfe_c1;
-    const T phi_0 = func(x);
     const T phi_prime_0 = g.dot(d);
     
     for (int i = 0; i < 20; ++i) {
-        if (func(x + step * d) <= phi_0 + c1 * step * phi_prime_0) {
+        phi_step = func(x + step * d);
+        if (phi_step <= phi_0 + c1 * step * phi_prime_0) {
             return step;
         }
+        if constexpr (telemetry_enabled) ++stats.line_search_backtracks;
         step *= 0.5;
     }
-    return step;
+    // 未找到满足 Armijo 条件的步长：不移动，避免走进约束墙 (如返回 1e10 的非法区域)
+    if constexpr (telemetry_enabled) ++stats.line_search_failures;
+    phi_step = phi_0;
+    return 0;
 }
 
 template <FloatingPoint T>
@@ -64,10 +80,22 @@ OptimizationResult<T> LBFGSOptimizer<T>::minimize(
     OptimizationResult<T> res;
     res.x_best = x0;
     res.converged = false;
+    OptimizationStats<T>& stats = res.stats;
+
+    // 遥测开启时包装目标函数以统计调用次数
+    ObjectiveFunc<T> counted;
+    if constexpr (telemetry_enabled) {
+        counted = [&stats, &func](const Eigen::VectorX<T>& theta) {
+            ++stats.objective_evaluations;
+            return func(theta);
+        };
+    }
+    const ObjectiveFunc<T>& objective = telemetry_enabled ? counted : func;
     
     std::deque<StepHistory> history;
     Eigen::VectorX<T> x = x0;
-    Eigen::VectorX<T> g = estimate_gradient(func, x);
+    T fx = objective(x);
+    Eigen::VectorX<T> g = estimate_gradient(objective, x, stats);
 
     for (int iter = 0; iter < config_.max_iter; ++iter) {
         if (g.norm() < config_.g_tol) {
@@ -76,30 +104,80 @@ OptimizationResult<T> LBFGSOptimizer<T>::minimize(
         }
 
         Eigen::VectorX<T> d = compute_direction(g, history);
-        T alpha = line_search(func, x, g, d, config_.step_alpha);
+        if (g.dot(d) >= 0) { // 曲率历史失效，退回最速下降
+            history.clear();
+            d = -g;
+            if constexpr (telemetry_enabled) ++stats.history_resets;
+        }
+
+        // 无曲率历史时 d 即 -g，其尺度与问题无关：把首个试探步限制在单位长度内，
+        // 否则梯度很大时 (如 GARCH 的 omega 方向) 回溯 20 次仍停留在约束墙外
+        const T initial_step = history.empty()
+            ? config_.step_alpha / std::max(T(1), d.norm())
+            : config_.step_alpha;
+
+        T fx_next;
+        T alpha = line_search(objective, x, fx, g, d, initial_step, fx_next, stats);
+        if (alpha == 0) {
+            // 线搜索失败：先清空历史以最速下降重试，已是最速下降则无法继续
+            res.iterations = iter + 1;
+            const bool keep_going = this->notify_iteration(stats, {iter, fx, g.norm(), T(0)});
+            if (history.empty() || !keep_going) break;
+            history.clear();
+            if constexpr (telemetry_enabled) ++stats.history_resets;
+            continue;
+        }
         
         Eigen::VectorX<T> x_next = x + alpha * d;
-        Eigen::VectorX<T> g_next = estimate_gradient(func, x_next);
+        Eigen::VectorX<T> g_next = estimate_gradient(objective, x_next, stats);
 
         Eigen::VectorX<T> s = x_next - x;
         Eigen::VectorX<T> y = g_next - g;
         T sy = s.dot(y);
         if (sy > 1e-10) { // 保持 Hessian 正定性
             if (history.size() >= static_cast<std::size_t>(config_.m)) history.pop_front();
-            history.push_back({s, y, 1.0 / sy});
+            history.push_back({s, y, T(1) / sy});
         }
 
+        const T decrease = fx - fx_next;
         x = x_next;
         g = g_next;
-        res.iterations = iter;
+        fx = fx_next;
+        res.iterations = iter + 1;
+
+        if (!this->notify_iteration(stats, {iter, fx, g.norm(), alpha})) break;
+        if (decrease <= config_.f_tol * std::max(T(1), std::abs(fx))) {
+            res.converged = true;
+            break;
+        }
     }
 
     res.x_best = x;
-    res.min_value = func(x);
+    res.min_value = fx;
+    stats.unconverged_runs = res.converged ? 0 : 1;
     return res;
 }
 
 template class LBFGSOptimizer<double>;
 template class LBFGSOptimizer<float>;
 
+template <FloatingPoint T>
+std::unique_ptr<Optimizer<T>> make_optimizer(OptimizerKind kind, std::size_t threads) {
+    switch (kind) {
+        case OptimizerKind::NelderMead:
+            return std::make_unique<NelderMeadOptimizer<T>>();
+        case OptimizerKind::DifferentialEvolution: {
+            typename DifferentialEvolutionOptimizer<T>::Config config;
+            config.threads = threads;
+            return std::make_unique<DifferentialEvolutionOptimizer<T>>(config);
+        }
+        case OptimizerKind::LBFGS:
+        default:
+            return std::make_unique<LBFGSOptimizer<T>>();
+    }
+}
+
+template std::unique_ptr<Optimizer<double>> make_optimizer<double>(OptimizerKind kind, std::size_t threads);
+template std::unique_ptr<Optimizer<float>> make_optimizer<float>(OptimizerKind kind, std::size_t threads);
+
 } // namespace openrisk::core
@@ -1,48 +1,185 @@
 #include "openrisk/crash/lppl.hpp"
-#include "openrisk/core/lbfgs.hpp"
+#include "openrisk/core/stats.hpp"
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <limits>
+#include <utility>
+#include <vector>
 #include <iostream>
 
 namespace openrisk::crash {
 
+namespace {
+
+template <core::FloatingPoint Acc>
+struct LinearFit {
+    Acc sse;
+    Acc A;
+    Acc B;
+    Acc C1; // C cos(phi)
+    Acc C2; // -C sin(phi)
+};
+
+/**
+ * @brief 给定 (tc, m, omega)，最小二乘求解 LPPL 的线性参数
+ * log p = A + B f + C1 f cos(omega ln dt) + C2 f sin(omega ln dt)，f = dt^m。
+ * 按块构造设计矩阵并累加 4x4 正规方程，不分配堆内存。m 趋于 0 时 f 与常数列近似共线，
+ * 正规方程按对角线缩放后用完全正交分解求解 (秩亏时取最小范数解)；
+ * SSE 在第二遍中由实际残差求和，而不是用 y'y - coef' X'y 相减 (两者接近时会抵消为噪声)。
+ */
+template <core::FloatingPoint T, core::FloatingPoint Acc>
+LinearFit<Acc> solve_linear_params(core::ConstVectorRef<T> t_series, core::ConstVectorRef<T> log_p_series,
+                                   Acc tc, Acc m, Acc omega) {
+    constexpr Eigen::Index block = 256;
+    const Eigen::Index n = t_series.size();
+
+    Eigen::Matrix<Acc, block, 4> x;
+    Eigen::Matrix<Acc, block, 1> y;
+    Eigen::Array<Acc, block, 1> log_dt;
+    Eigen::Array<Acc, block, 1> f;
+    Eigen::Matrix<Acc, 4, 4> xtx = Eigen::Matrix<Acc, 4, 4>::Zero();
+    Eigen::Matrix<Acc, 4, 1> xty = Eigen::Matrix<Acc, 4, 1>::Zero();
+
+    auto fill_block = [&](Eigen::Index b, Eigen::Index len) {
+        log_dt.head(len) = (tc - t_series.segment(b, len).template cast<Acc>().array())
+                               .max(std::numeric_limits<Acc>::min()).log();
+        f.head(len) = (m * log_dt.head(len)).exp();
+        x.col(0).head(len).setOnes();
+        x.col(1).head(len) = f.head(len).matrix();
+        x.col(2).head(len) = (f.head(len) * (omega * log_dt.head(len)).cos()).matrix();
+        x.col(3).head(len) = (f.head(len) * (omega * log_dt.head(len)).sin()).matrix();
+        y.head(len) = log_p_series.segment(b, len).template cast<Acc>();
+    };
+
+    for (Eigen::Index b = 0; b < n; b += block) {
+        const Eigen::Index len = std::min(block, n - b);
+        fill_block(b, len);
+        xtx.noalias() += x.topRows(len).transpose() * x.topRows(len);
+        xty.noalias() += x.topRows(len).transpose() * y.head(len);
+    }
+
+    const Eigen::Matrix<Acc, 4, 1> scale =
+        (xtx.diagonal().array() > 0).select(xtx.diagonal().array().rsqrt(), Acc(1)).matrix();
+    const Eigen::Matrix<Acc, 4, 4> scaled = scale.asDiagonal() * xtx * scale.asDiagonal();
+    const Eigen::Matrix<Acc, 4, 1> coef =
+        scale.cwiseProduct(scaled.completeOrthogonalDecomposition().solve(scale.cwiseProduct(xty)));
+
+    Acc sse = 0;
+    for (Eigen::Index b = 0; b < n; b += block) {
+        const Eigen::Index len = std::min(block, n - b);
+        fill_block(b, len);
+        sse += (y.head(len) - x.topRows(len) * coef).squaredNorm();
+    }
+    return {sse, coef(0), coef(1), coef(2), coef(3)};
+}
+
+} // namespace
+
 template <core::FloatingPoint T>
-LPPLParams<T> LPPLCalibrator<T>::calibrate(const Eigen::VectorX<T>& t_series, 
-                                           const Eigen::VectorX<T>& log_p_series,
-                                           T t_last) {
-    core::LBFGSOptimizer<T> opt;
+LPPLParams<T> LPPLCalibrator<T>::calibrate(core::ConstVectorRef<T> t_series, 
+                                           core::ConstVectorRef<T> log_p_series,
+                                           T t_last,
+                                           const LPPLCalibrationConfig<T>& config) {
+    // 数据保持 T 精度，参数与优化器使用累加精度 (float 数据时为 double)
+    using Acc = core::accumulator_t<T>;
+    auto opt = core::make_optimizer<Acc>(config.optimizer);
+    opt->set_observer(config.observer);
+    opt->set_record_trajectory(config.record_trajectory);
+    if (config.stats) *config.stats = {};
+    const Acc t_end = t_last;
+
+    if (config.optimizer != core::OptimizerKind::LBFGS) {
+        // 变量投影：只搜索 (u, m, omega)，u = (tc - t_last) / 窗口长度，使三个坐标量级相近
+        const Acc span = std::max<Acc>(t_end - static_cast<Acc>(t_series.minCoeff()), 1);
+        const Acc u_min = static_cast<Acc>(1e-3);
+        const Acc u_max = std::max<Acc>(static_cast<Acc>(config.max_horizon), 2 * u_min);
+        Eigen::VectorX<Acc> lb(3);
+        Eigen::VectorX<Acc> ub(3);
+        lb << u_min, 0.01, 2.0;
+        ub << u_max, 0.99, 25.0;
+
+        auto projected = [&](const Eigen::VectorX<Acc>& theta) -> Acc {
+            return solve_linear_params<T, Acc>(t_series, log_p_series, t_end + theta(0) * span, theta(1), theta(2)).sse;
+        };
+
+        // 投影后的目标在 tc 方向高度多峰，单个起点的 Nelder-Mead 常停在 tc 下界附近的局部极小。
+        // 先在粗网格上评估 (u 按对数等距，靠近 t_last 处更密)，再从最好的若干网格点出发局部搜索。
+        constexpr int grid_u = 12;
+        constexpr std::array<Acc, 3> grid_m{0.25, 0.5, 0.75};
+        constexpr std::array<Acc, 5> grid_omega{4.0, 6.0, 9.0, 13.0, 18.0};
+        std::vector<std::pair<Acc, Eigen::Vector3<Acc>>> grid;
+        grid.reserve(grid_u * grid_m.size() * grid_omega.size());
+        for (int i = 0; i < grid_u; ++i) {
+            const Acc u = 2 * u_min * std::pow(u_max / (2 * u_min), Acc(i) / (grid_u - 1));
+            for (Acc m : grid_m) {
+                for (Acc omega : grid_omega) {
+                    Eigen::Vector3<Acc> theta(u, m, omega);
+                    grid.emplace_back(projected(theta), theta);
+                }
+            }
+        }
+        // 差分进化本身是全局搜索，只从最好的网格点出发一次
+        const std::size_t starts = std::min<std::size_t>(
+            config.optimizer == core::OptimizerKind::NelderMead ? 3 : 1, grid.size());
+        std::partial_sort(grid.begin(), grid.begin() + starts, grid.end(),
+                          [](const auto& a, const auto& b) { return a.first < b.first; });
+        if constexpr (core::telemetry_enabled) {
+            if (config.stats) config.stats->objective_evaluations += static_cast<long>(grid.size());
+        }
+
+        Eigen::VectorX<Acc> best_x = grid.front().second;
+        Acc min_loss = grid.front().first;
+        for (std::size_t s = 0; s < starts; ++s) {
+            auto result = opt->minimize(projected, Eigen::VectorX<Acc>(grid[s].second), lb, ub);
+            if (config.stats) core::merge_stats(*config.stats, result.stats);
+            if (result.x_best.size() == 3 && result.min_value < min_loss) {
+                min_loss = result.min_value;
+                best_x = result.x_best;
+            }
+        }
+
+        const Acc tc = t_end + best_x(0) * span;
+        auto fit = solve_linear_params<T, Acc>(t_series, log_p_series, tc, best_x(1), best_x(2));
+        return {static_cast<T>(fit.A), static_cast<T>(fit.B), static_cast<T>(std::hypot(fit.C1, fit.C2)),
+                static_cast<T>(tc), static_cast<T>(best_x(1)), static_cast<T>(best_x(2)),
+                static_cast<T>(std::atan2(-fit.C2, fit.C1))};
+    }
     
-    auto objective = [&](const Eigen::VectorX<T>& theta) -> T {
-        if (theta.size() < 7) return static_cast<T>(1e10);
+    auto objective = [&](const Eigen::VectorX<Acc>& theta) -> Acc {
+        if (theta.size() < 7) return static_cast<Acc>(1e10);
         
-        LPPLParams<T> p{
+        LPPLParams<Acc> p{
             theta(0), theta(1), theta(2), theta(3), theta(4), theta(5), theta(6)
         };
 
-        T sse = LPPLModel<T>::cost_function(t_series, log_p_series, p);
+        Acc sse = LPPLModel<T>::cost_function(t_series, log_p_series, p);
         
-        T penalty = 0.0;
-        const T lambda = 1e6;
+        Acc penalty = 0.0;
+        const Acc lambda = 1e6;
         if (p.m <= 0.0 || p.m >= 1.0) penalty += lambda * std::pow(p.m - 0.5, 2);
-        if (p.tc <= t_last) penalty += lambda * std::pow(t_last - p.tc + 1.0, 2);
+        if (p.tc <= t_end) penalty += lambda * std::pow(t_end - p.tc + 1.0, 2);
 
         return sse + penalty;
     };
 
-    Eigen::VectorX<T> best_x(7);
-    best_x << log_p_series.mean(), -0.1, 0.01, t_last + 30.0, 0.5, 8.0, 0.0;
+    const Acc log_p_mean = core::Statistics<T>::mean(log_p_series);
+
+    Eigen::VectorX<Acc> best_x(7);
+    best_x << log_p_mean, -0.1, 0.01, t_end + 30.0, 0.5, 8.0, 0.0;
     
-    T min_loss = std::numeric_limits<T>::max();
+    Acc min_loss = std::numeric_limits<Acc>::max();
 
-    std::vector<T> m_seeds = {0.5};
-    std::vector<T> omega_seeds = {8.0};
+    std::vector<Acc> m_seeds = {0.5};
+    std::vector<Acc> omega_seeds = {8.0};
 
     for (auto m_s : m_seeds) {
         for (auto o_s : omega_seeds) {
-            Eigen::VectorX<T> x0(7);
-            x0 << log_p_series.mean(), -0.1, 0.01, t_last + 30.0, m_s, o_s, 0.0;
+            Eigen::VectorX<Acc> x0(7);
+            x0 << log_p_mean, -0.1, 0.01, t_end + 30.0, m_s, o_s, 0.0;
             
-            auto result = opt.minimize(objective, x0, Eigen::VectorX<T>(), Eigen::VectorX<T>());
+            auto result = opt->minimize(objective, x0, Eigen::VectorX<Acc>(), Eigen::VectorX<Acc>());
+            if (config.stats) core::merge_stats(*config.stats, result.stats);
             
             if (result.x_best.size() == 7 && result.min_value < min_loss) {
                 min_loss = result.min_value;
@@ -51,9 +188,11 @@ LPPLParams<T> LPPLCalibrator<T>::calibrate(const Eigen::VectorX<T>& t_series,
         }
     }
 
-    return {best_x(0), best_x(1), best_x(2), best_x(3), best_x(4), best_x(5), best_x(6)};
+    Eigen::VectorX<T> x = best_x.template cast<T>();
+    return {x(0), x(1), x(2), x(3), x(4), x(5), x(6)};
 }
 
 template class LPPLCalibrator<double>;
+template class LPPLCalibrator<float>;
 
 } // namespace openrisk::crash
@@ -1,5 +1,6 @@
 #pragma once
 #include "openrisk/core/concepts.hpp"
+#include <stdexcept>
 
 namespace openrisk::factor {
 
@@ -13,10 +14,10 @@ public:
      * @param factor_cov 因子协方差矩阵 (K x K)
      * @param specific_var 特异性风险向量 (N x 1)
      */
-    static T total_variance(const Eigen::VectorX<T>& weights,
-                            const Eigen::MatrixX<T>& beta,
-                            const Eigen::MatrixX<T>& factor_cov,
-                            const Eigen::VectorX<T>& specific_var) {
+    static T total_variance(core::ConstVectorRef<T> weights,
+                            core::ConstMatrixRef<T> beta,
+                            core::ConstMatrixRef<T> factor_cov,
+                            core::ConstVectorRef<T> specific_var) {
         Eigen::VectorX<T> exposure = beta.transpose() * weights;
         T factor_risk = exposure.transpose() * factor_cov * exposure;
 
@@ -29,11 +30,30 @@ public:
      * @brief 计算MCTR
      */
     static Eigen::VectorX<T> marginal_contribution_to_risk(
-        const Eigen::VectorX<T>& weights,
-        const Eigen::MatrixX<T>& full_covariance) {
+        core::ConstVectorRef<T> weights,
+        core::ConstMatrixRef<T> full_covariance) {
         
-        T portfolio_vol = std::sqrt(weights.transpose() * full_covariance * weights);
-        return (full_covariance * weights) / portfolio_vol;
+        Eigen::VectorX<T> mctr(weights.size());
+        marginal_contribution_to_risk(weights, full_covariance, mctr);
+        return mctr;
+    }
+
+    /**
+     * @brief 计算MCTR，结果写入调用方预先分配的 mctr (N x 1)
+     * @throws std::invalid_argument full_covariance 不是 N x N 或 mctr 长度不是 N
+     */
+    static void marginal_contribution_to_risk(
+        core::ConstVectorRef<T> weights,
+        core::ConstMatrixRef<T> full_covariance,
+        core::VectorRef<T> mctr) {
+        
+        if (full_covariance.rows() != weights.size() || full_covariance.cols() != weights.size() ||
+            mctr.size() != weights.size()) {
+            throw std::invalid_argument("RiskAttribution::marginal_contribution_to_risk: inconsistent dimensions");
+        }
+        mctr.noalias() = full_covariance * weights;
+        T portfolio_vol = std::sqrt(weights.dot(mctr));
+        mctr /= portfolio_vol;
     }
 };
 
@@ -0,0 +1,290 @@
+#include "openrisk/io/columnar.hpp"
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace openrisk::io {
+
+namespace {
+
+constexpr char kMagic[8] = {'O', 'R', 'C', 'O', 'L', 'U', 'M', 'N'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint64_t kAlignment = 64;
+
+// 文件末尾的定长 trailer
+struct Trailer {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t n_cols;
+    std::uint64_t rows;
+    std::uint64_t timestamps_offset;
+    std::uint64_t directory_offset;
+};
+
+// 目录项，其后紧跟 name_length 字节的列名
+struct DirectoryEntry {
+    std::uint32_t type;
+    std::uint32_t name_length;
+    std::uint64_t offset;
+};
+
+// [offset, offset + count * elem) 是否落在 [0, limit) 内，乘加均不溢出
+bool range_fits(std::uint64_t offset, std::uint64_t count, std::uint64_t elem, std::uint64_t limit) {
+    return offset <= limit && count <= (limit - offset) / elem;
+}
+
+bool known_type(std::uint32_t type) {
+    return type == static_cast<std::uint32_t>(DataType::Float64) ||
+           type == static_cast<std::uint32_t>(DataType::Float32);
+}
+
+} // namespace
+
+// ---------------------------------------------------------------- writer
+
+ColumnarWriter::ColumnarWriter(const std::string& path, const std::vector<std::int64_t>& timestamps)
+    : rows_(timestamps.size()) {
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        throw std::runtime_error("ColumnarWriter: cannot open '" + path + "'");
+    }
+    try {
+        timestamps_offset_ = position_;
+        write_block(timestamps.data(), rows_ * sizeof(std::int64_t));
+        pad_to_alignment();
+    } catch (...) {
+        // 构造失败时析构函数不会运行，需要在此关闭文件
+        std::fclose(file_);
+        file_ = nullptr;
+        throw;
+    }
+}
+
+ColumnarWriter::~ColumnarWriter() {
+    if (file_) {
+        try {
+            close();
+        } catch (...) {
+            // 析构中不传播异常，需要错误信息时应显式调用 close()
+        }
+    }
+}
+
+void ColumnarWriter::write_block(const void* data, std::uint64_t bytes) {
+    if (bytes > 0 && std::fwrite(data, 1, bytes, file_) != bytes) {
+        throw std::runtime_error("ColumnarWriter: write failed");
+    }
+    position_ += bytes;
+}
+
+void ColumnarWriter::pad_to_alignment() {
+    static const unsigned char zeros[kAlignment] = {};
+    const std::uint64_t rem = position_ % kAlignment;
+    if (rem != 0) write_block(zeros, kAlignment - rem);
+}
+
+void ColumnarWriter::write_column(const std::string& name, DataType type, const void* data, std::uint64_t bytes) {
+    if (!file_) {
+        throw std::logic_error("ColumnarWriter: add_column after close()");
+    }
+    columns_.push_back({name, type, position_});
+    write_block(data, bytes);
+    pad_to_alignment();
+}
+
+void ColumnarWriter::close() {
+    if (!file_) return;
+
+    const std::uint64_t directory_offset = position_;
+    for (const auto& col : columns_) {
+        DirectoryEntry entry{static_cast<std::uint32_t>(col.type),
+                             static_cast<std::uint32_t>(col.name.size()),
+                             col.offset};
+        write_block(&entry, sizeof(entry));
+        write_block(col.name.data(), col.name.size());
+    }
+
+    Trailer trailer{};
+    std::memcpy(trailer.magic, kMagic, sizeof(kMagic));
+    trailer.version = kVersion;
+    trailer.n_cols = static_cast<std::uint32_t>(columns_.size());
+    trailer.rows = rows_;
+    trailer.timestamps_offset = timestamps_offset_;
+    trailer.directory_offset = directory_offset;
+    write_block(&trailer, sizeof(trailer));
+
+    const bool ok = std::fclose(file_) == 0;
+    file_ = nullptr;
+    if (!ok) {
+        throw std::runtime_error("ColumnarWriter: close failed");
+    }
+}
+
+// ---------------------------------------------------------------- reader
+
+MappedColumnarFile::MappedColumnarFile(const std::string& path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("MappedColumnarFile: cannot open '" + path + "'");
+    }
+    file_handle_ = file;
+    LARGE_INTEGER file_size;
+    GetFileSizeEx(file, &file_size);
+    size_ = static_cast<std::size_t>(file_size.QuadPart);
+    if (size_ >= sizeof(Trailer)) {
+        mapping_handle_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_handle_) {
+            base_ = static_cast<const unsigned char*>(MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0));
+        }
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("MappedColumnarFile: cannot open '" + path + "'");
+    }
+    struct stat st;
+    if (::fstat(fd, &st) == 0) {
+        size_ = static_cast<std::size_t>(st.st_size);
+    }
+    if (size_ >= sizeof(Trailer)) {
+        void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        if (addr != MAP_FAILED) base_ = static_cast<const unsigned char*>(addr);
+    }
+    ::close(fd); // 映射建立后不再需要文件描述符
+#endif
+
+    if (!base_) {
+        unmap();
+        throw std::runtime_error("MappedColumnarFile: cannot map '" + path + "'");
+    }
+
+    Trailer trailer;
+    std::memcpy(&trailer, base_ + size_ - sizeof(Trailer), sizeof(Trailer));
+    if (std::memcmp(trailer.magic, kMagic, sizeof(kMagic)) != 0 || trailer.version != kVersion) {
+        unmap();
+        throw std::runtime_error("MappedColumnarFile: '" + path + "' is not a columnar file");
+    }
+
+    // 所有偏移与长度都来自文件内容，逐项校验后才允许通过视图访问
+    const std::size_t directory_end = size_ - sizeof(Trailer);
+    const std::uint64_t directory_offset = trailer.directory_offset;
+    bool valid = directory_offset <= directory_end &&
+                 trailer.timestamps_offset % sizeof(std::int64_t) == 0 &&
+                 range_fits(trailer.timestamps_offset, trailer.rows, sizeof(std::int64_t), directory_offset);
+
+    std::size_t pos = valid ? directory_offset : directory_end;
+    if (valid) columns_.reserve(std::min<std::uint64_t>(trailer.n_cols, (directory_end - pos) / sizeof(DirectoryEntry)));
+    for (std::uint32_t i = 0; valid && i < trailer.n_cols; ++i) {
+        DirectoryEntry entry;
+        if (directory_end - pos < sizeof(entry)) {
+            valid = false;
+            break;
+        }
+        std::memcpy(&entry, base_ + pos, sizeof(entry));
+        pos += sizeof(entry);
+        if (directory_end - pos < entry.name_length || !known_type(entry.type)) {
+            valid = false;
+            break;
+        }
+        std::string name(reinterpret_cast<const char*>(base_ + pos), entry.name_length);
+        pos += entry.name_length;
+
+        const std::size_t elem = (static_cast<DataType>(entry.type) == DataType::Float64) ? sizeof(double) : sizeof(float);
+        if (entry.offset % elem != 0 || !range_fits(entry.offset, trailer.rows, elem, directory_offset)) {
+            valid = false;
+            break;
+        }
+        columns_.push_back({std::move(name), static_cast<DataType>(entry.type), entry.offset});
+    }
+    if (!valid) {
+        unmap();
+        throw std::runtime_error("MappedColumnarFile: '" + path + "' is truncated or corrupt");
+    }
+
+    rows_ = static_cast<std::size_t>(trailer.rows);
+    timestamps_offset_ = trailer.timestamps_offset;
+}
+
+MappedColumnarFile::~MappedColumnarFile() {
+    unmap();
+}
+
+MappedColumnarFile::MappedColumnarFile(MappedColumnarFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedColumnarFile& MappedColumnarFile::operator=(MappedColumnarFile&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        base_ = std::exchange(other.base_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        rows_ = std::exchange(other.rows_, 0);
+        timestamps_offset_ = other.timestamps_offset_;
+        columns_ = std::move(other.columns_);
+#ifdef _WIN32
+        file_handle_ = std::exchange(other.file_handle_, nullptr);
+        mapping_handle_ = std::exchange(other.mapping_handle_, nullptr);
+#endif
+    }
+    return *this;
+}
+
+void MappedColumnarFile::unmap() noexcept {
+#ifdef _WIN32
+    if (base_) UnmapViewOfFile(base_);
+    if (mapping_handle_) CloseHandle(mapping_handle_);
+    if (file_handle_) CloseHandle(file_handle_);
+    mapping_handle_ = nullptr;
+    file_handle_ = nullptr;
+#else
+    if (base_) ::munmap(const_cast<unsigned char*>(base_), size_);
+#endif
+    base_ = nullptr;
+}
+
+std::size_t MappedColumnarFile::column_index(std::string_view name) const {
+    for (std::size_t i = 0; i < columns_.size(); ++i) {
+        if (columns_[i].name == name) return i;
+    }
+    throw std::out_of_range("MappedColumnarFile: no column named '" + std::string(name) + "'");
+}
+
+void MappedColumnarFile::advise_sequential() const {
+#ifndef _WIN32
+    ::madvise(const_cast<unsigned char*>(base_), size_, MADV_SEQUENTIAL);
+#endif
+}
+
+void MappedColumnarFile::release_rows(std::size_t begin, std::size_t rows) const {
+#ifndef _WIN32
+    // 只释放完全落在 [begin, begin + rows) 内的整页，相邻块共享的边界页保留
+    static const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto release = [&](std::uint64_t offset, std::size_t elem) {
+        std::uintptr_t lo = reinterpret_cast<std::uintptr_t>(base_ + offset + begin * elem);
+        std::uintptr_t hi = lo + rows * elem;
+        lo = (lo + page - 1) / page * page;
+        hi = hi / page * page;
+        if (hi > lo) ::madvise(reinterpret_cast<void*>(lo), hi - lo, MADV_DONTNEED);
+    };
+    release(timestamps_offset_, sizeof(std::int64_t));
+    for (const auto& col : columns_) {
+        release(col.offset, col.type == DataType::Float64 ? sizeof(double) : sizeof(float));
+    }
+#else
+    (void)begin;
+    (void)rows;
+#endif
+}
+
+} // namespace openrisk::io
@@ -1,46 +1,195 @@
 #include "openrisk/time_series/garch.hpp"
-#include "openrisk/core/lbfgs.hpp"
 #include "openrisk/core/stats.hpp"
 #include <iostream>
 
 namespace openrisk::time_series {
 
-template <core::FloatingPoint T>
-GarchParams<T> calibrate_garch(const Eigen::VectorX<T>& returns) {
-    if (returns.size() < 5) {
-        return {static_cast<T>(0.0001), static_cast<T>(0.05), static_cast<T>(0.9)};
-    }
+namespace {
 
-    core::LBFGSOptimizer<T> opt;
-    
-    auto objective = [&](const Eigen::VectorX<T>& theta) -> T {
-        if (theta.size() < 3) return static_cast<T>(1e10);
+// 参数向量布局：(omega / omega_scale, alpha, beta, [gamma], [nu])
+// omega 按样本方差缩放到 O(1)，使各坐标的梯度量级相近
+template <GarchVariant V, Innovation I>
+constexpr Eigen::Index parameter_count = 3 + (V != GarchVariant::Symmetric ? 1 : 0) + (I == Innovation::StudentT ? 1 : 0);
 
+template <GarchVariant V, Innovation I, core::FloatingPoint Acc>
+GarchParams<Acc> unpack(const Eigen::VectorX<Acc>& theta, Acc omega_scale) {
+    GarchParams<Acc> params{theta(0) * omega_scale, theta(1), theta(2)};
+    Eigen::Index k = 3;
+    if constexpr (V != GarchVariant::Symmetric) params.gamma = theta(k++);
+    if constexpr (I == Innovation::StudentT) params.nu = theta(k++);
+    return params;
+}
+
+// 平稳性与正定性约束
+template <GarchVariant V, Innovation I, core::FloatingPoint Acc>
+bool admissible(const GarchParams<Acc>& p) {
+    if constexpr (I == Innovation::StudentT) {
+        if (p.nu <= 2) return false;
+    }
+    if constexpr (V == GarchVariant::Symmetric) {
         // omega > 0, alpha, beta >= 0, alpha + beta < 1
-        if (theta(0) <= 0 || theta(1) < 0 || theta(2) < 0 || (theta(1) + theta(2) >= 1.0)) {
-            return static_cast<T>(1e10); 
+        return p.omega > 0 && p.alpha >= 0 && p.beta >= 0 && p.alpha + p.beta < 1;
+    } else if constexpr (V == GarchVariant::GJR) {
+        // 负收益时 ARCH 系数 alpha + gamma 也须非负，持续性 alpha + gamma / 2 + beta < 1
+        return p.omega > 0 && p.alpha >= 0 && p.alpha + p.gamma >= 0 && p.beta >= 0 &&
+               p.alpha + p.gamma / 2 + p.beta < 1;
+    } else {
+        // EGARCH 直接对 log sigma^2 建模，只需 |beta| < 1
+        return std::abs(p.beta) < 1;
+    }
+}
+
+// 样本过短无法标定时的默认参数：alpha = 0.05, beta = 0.9, 无杠杆
+// 对称 / GJR 的 omega 取固定值 1e-4；EGARCH 的 omega 作用于 log 方差，
+// 取 (1 - beta) 倍样本 log 方差，使无条件 log 方差与样本一致 (样本不足两点时用前者隐含的方差)
+template <GarchVariant V, Innovation I, core::FloatingPoint T>
+GarchParams<T> fallback_params(core::ConstVectorRef<T> returns) {
+    using Acc = core::accumulator_t<T>;
+    const Acc alpha = Acc(0.05);
+    const Acc beta = Acc(0.9);
+    Acc omega = Acc(0.0001);
+    if constexpr (V == GarchVariant::EGARCH) {
+        Acc var = omega / (1 - alpha - beta);
+        if (returns.size() >= 2) {
+            const Acc sample_var = core::Statistics<T>::variance(returns);
+            if (core::is_finite(sample_var) && sample_var > 0) var = sample_var;
+        }
+        omega = (1 - beta) * std::log(var);
+    }
+    GarchParams<T> fallback{static_cast<T>(omega), static_cast<T>(alpha), static_cast<T>(beta)};
+    if constexpr (I == Innovation::StudentT) fallback.nu = static_cast<T>(8);
+    return fallback;
+}
+
+template <GarchVariant V, Innovation I, core::FloatingPoint T>
+GarchParams<T> calibrate(core::ConstVectorRef<T> returns, const GarchCalibrationConfig<T>& config) {
+    if (returns.size() < 5) return fallback_params<V, I, T>(returns);
+
+    // 数据保持 T 精度，参数与优化器使用累加精度 (float 数据时为 double)，
+    // 否则有限差分梯度的扰动会被 float 舍入吞掉
+    using Acc = core::accumulator_t<T>;
+    constexpr Eigen::Index dims = parameter_count<V, I>;
+    auto opt = core::make_optimizer<Acc>(config.optimizer, config.optimizer_threads);
+    opt->set_observer(config.observer);
+    opt->set_record_trajectory(config.record_trajectory);
+
+    Eigen::VectorX<Acc> x0(dims);
+    Eigen::VectorX<Acc> lb(dims);
+    Eigen::VectorX<Acc> ub(dims);
+    Acc var = core::Statistics<T>::variance(returns);
+    // EGARCH 的 omega 作用于 log 方差，本身已是 O(1)
+    const Acc omega_scale = V == GarchVariant::EGARCH ? Acc(1) : var;
+
+    auto objective = [&](const Eigen::VectorX<Acc>& theta) -> Acc {
+        if (theta.size() < dims) return static_cast<Acc>(1e10);
+
+        const GarchParams<Acc> params = unpack<V, I>(theta, omega_scale);
+        if (!admissible<V, I>(params)) {
+            return static_cast<Acc>(1e10);
         }
-        
-        GarchParams<T> params{theta(0), theta(1), theta(2)};
-        return GarchModel<T>::log_likelihood(returns, params);
+
+        const Acc nll = GarchModel<T, V, I>::log_likelihood(returns, params);
+        // NaN 若进入 Nelder-Mead 的排序会破坏严格弱序，这里按位检查 (不受 -ffast-math 影响)
+        return core::is_finite(nll) ? nll : static_cast<Acc>(1e10);
     };
 
-    Eigen::VectorX<T> x0(3);
-    T var = core::Statistics<T>::variance(returns);
-    // omega较小，alpha=0.1, beta=0.8
-    x0 << var * static_cast<T>(0.1), static_cast<T>(0.1), static_cast<T>(0.8);
+    // 搜索区间仅供 Nelder-Mead (截断) 与差分进化 (采样) 使用，平稳性约束仍由目标函数保证
+    if constexpr (V == GarchVariant::Symmetric) {
+        // omega = 0.1 倍样本方差，alpha=0.1, beta=0.8 (无条件方差即样本方差)
+        x0.head(3) << static_cast<Acc>(0.1), static_cast<Acc>(0.1), static_cast<Acc>(0.8);
+        lb.head(3) << static_cast<Acc>(1e-6), 0, 0;
+        ub.head(3) << 1, 1, 1;
+    } else if constexpr (V == GarchVariant::GJR) {
+        // 与对称模型相同的持续性 0.9，其中一半 ARCH 效应来自负收益
+        x0.head(4) << static_cast<Acc>(0.1), static_cast<Acc>(0.05), static_cast<Acc>(0.8), static_cast<Acc>(0.1);
+        lb.head(4) << static_cast<Acc>(1e-6), 0, 0, -1;
+        ub.head(4) << 1, 1, 1, 1;
+    } else {
+        // 无条件 log 方差 omega / (1 - beta) 取样本 log 方差
+        const Acc log_var = std::log(var);
+        x0.head(4) << static_cast<Acc>(0.05) * log_var, static_cast<Acc>(0.1), static_cast<Acc>(0.95), 0;
+        lb.head(4) << -2 * std::abs(log_var), 0, 0, -1;
+        ub.head(4) << 2 * std::abs(log_var), 1, static_cast<Acc>(0.9999), 1;
+    }
+    if constexpr (I == Innovation::StudentT) {
+        x0(dims - 1) = 8;
+        lb(dims - 1) = static_cast<Acc>(2.1);
+        ub(dims - 1) = 100;
+    }
 
-    auto result = opt.minimize(objective, x0, Eigen::VectorX<T>(), Eigen::VectorX<T>());
+    auto result = opt->minimize(objective, x0, lb, ub);
+    if (config.optimizer == core::OptimizerKind::LBFGS && !result.converged && result.x_best.size() == dims) {
+        // 有限差分梯度跨过平稳性约束墙时 L-BFGS 会停在墙上，改用 Nelder-Mead 从其最好点继续
+        auto polish = core::make_optimizer<Acc>(core::OptimizerKind::NelderMead);
+        polish->set_observer(config.observer);
+        polish->set_record_trajectory(config.record_trajectory);
+        auto refined = polish->minimize(objective, result.x_best, lb, ub);
+        core::merge_stats(refined.stats, result.stats);
+        refined.stats.unconverged_runs = refined.converged ? 0 : 1;
+        if (refined.x_best.size() != dims || refined.min_value > result.min_value) {
+            refined.x_best = std::move(result.x_best);
+            refined.min_value = result.min_value;
+        }
+        result = std::move(refined);
+    }
+    if (config.stats) *config.stats = std::move(result.stats);
 
     // 如果优化器由于某种原因返回了空向量，或者 size 不对，直接返回初始值 x0
-    if (result.x_best.size() < 3) {
-        return {x0(0), x0(1), x0(2)};
+    const Eigen::VectorX<Acc>& x = (result.x_best.size() < dims) ? x0 : result.x_best;
+    const GarchParams<Acc> fit = unpack<V, I>(x, omega_scale);
+
+    return {static_cast<T>(fit.omega), static_cast<T>(fit.alpha), static_cast<T>(fit.beta),
+            static_cast<T>(fit.gamma), static_cast<T>(fit.nu)};
+}
+
+template <Innovation I, core::FloatingPoint T>
+GarchParams<T> dispatch_variant(core::ConstVectorRef<T> returns, const GarchCalibrationConfig<T>& config) {
+    switch (config.variant) {
+        case GarchVariant::GJR: return calibrate<GarchVariant::GJR, I, T>(returns, config);
+        case GarchVariant::EGARCH: return calibrate<GarchVariant::EGARCH, I, T>(returns, config);
+        case GarchVariant::Symmetric: break;
+    }
+    return calibrate<GarchVariant::Symmetric, I, T>(returns, config);
+}
+
+} // namespace
+
+template <core::FloatingPoint T>
+GarchParams<T> calibrate_garch(core::ConstVectorRef<T> returns, const GarchCalibrationConfig<T>& config) {
+    if (config.innovation == Innovation::StudentT) {
+        return dispatch_variant<Innovation::StudentT, T>(returns, config);
+    }
+    return dispatch_variant<Innovation::Gaussian, T>(returns, config);
+}
+
+template <core::FloatingPoint T>
+std::vector<GarchParams<T>> calibrate_garch_panel(core::ConstMatrixRef<T> returns,
+                                                  const GarchCalibrationConfig<T>& config,
+                                                  std::size_t max_threads) {
+    using Acc = core::accumulator_t<T>;
+    const std::size_t n_assets = returns.cols();
+    std::vector<GarchParams<T>> params(n_assets);
+    std::vector<core::OptimizationStats<Acc>> stats(config.stats ? n_assets : 0);
+
+    core::parallel_for(0, n_assets, [&](std::size_t j) {
+        GarchCalibrationConfig<T> column_config = config;
+        column_config.observer = nullptr;
+        column_config.optimizer_threads = 1;
+        column_config.stats = config.stats ? &stats[j] : nullptr;
+        params[j] = calibrate_garch<T>(returns.col(j), column_config);
+    }, 1, max_threads);
+
+    if (config.stats) {
+        *config.stats = {};
+        for (const auto& s : stats) core::merge_stats(*config.stats, s);
     }
-    
-    return {result.x_best(0), result.x_best(1), result.x_best(2)};
+    return params;
 }
 
 // 显式实例化
-template GarchParams<double> calibrate_garch<double>(const Eigen::VectorX<double>& returns);
+template GarchParams<double> calibrate_garch<double>(core::ConstVectorRef<double> returns, const GarchCalibrationConfig<double>& config);
+template GarchParams<float> calibrate_garch<float>(core::ConstVectorRef<float> returns, const GarchCalibrationConfig<float>& config);
+template std::vector<GarchParams<double>> calibrate_garch_panel<double>(core::ConstMatrixRef<double> returns, const GarchCalibrationConfig<double>& config, std::size_t max_threads);
+template std::vector<GarchParams<float>> calibrate_garch_panel<float>(core::ConstMatrixRef<float> returns, const GarchCalibrationConfig<float>& config, std::size_t max_threads);
 
 } // namespace openrisk::time_series
@@ -0,0 +1,104 @@
+#include "test_common.hpp"
+#include "openrisk/core/stats.hpp"
+#include "openrisk/crash/lppl.hpp"
+#include "openrisk/time_series/garch.hpp"
+
+namespace openrisk::test {
+namespace {
+
+using crash::LPPLCalibrationConfig;
+using crash::LPPLCalibrator;
+using crash::LPPLModel;
+using time_series::GarchCalibrationConfig;
+using time_series::GarchModel;
+using time_series::GarchParams;
+
+class GarchCalibration : public ::testing::TestWithParam<core::OptimizerKind> {};
+
+TEST_P(GarchCalibration, RecoversSimulationParameters) {
+    const auto returns = garch_returns<double>(20'000);
+    GarchCalibrationConfig<double> config;
+    config.optimizer = GetParam();
+    core::OptimizationStats<double> stats;
+    config.stats = &stats;
+
+    const auto fit = time_series::calibrate_garch<double>(returns, config);
+    EXPECT_EQ(stats.unconverged_runs, 0);
+    EXPECT_NEAR(fit.alpha, 0.08, 0.02);
+    EXPECT_NEAR(fit.beta, 0.9, 0.03);
+    EXPECT_NEAR(fit.alpha + fit.beta, 0.98, 0.01);
+    // 不应停在初始点 (omega = 0.1 倍样本方差, alpha = 0.1, beta = 0.8)
+    const GarchParams<double> x0{0.1 * core::Statistics<double>::variance(returns), 0.1, 0.8};
+    EXPECT_GT(GarchModel<double>::log_likelihood(returns, x0), GarchModel<double>::log_likelihood(returns, fit) + 10);
+}
+
+TEST_P(GarchCalibration, FloatMatchesDouble) {
+    const auto returns = garch_returns<double>(5'000);
+    GarchCalibrationConfig<double> config;
+    config.optimizer = GetParam();
+    GarchCalibrationConfig<float> float_config;
+    float_config.optimizer = GetParam();
+
+    const auto reference = time_series::calibrate_garch<double>(returns, config);
+    const auto value = time_series::calibrate_garch<float>(returns.cast<float>(), float_config);
+    EXPECT_NEAR(value.alpha, reference.alpha, 1e-3);
+    EXPECT_NEAR(value.beta, reference.beta, 1e-3);
+    EXPECT_TRUE(relatively_near(GarchModel<double>::log_likelihood(returns, GarchParams<double>{value.omega, value.alpha, value.beta}),
+                                GarchModel<double>::log_likelihood(returns, reference), 1e-6));
+}
+
+INSTANTIATE_TEST_SUITE_P(Optimizers, GarchCalibration,
+                         ::testing::Values(core::OptimizerKind::LBFGS, core::OptimizerKind::NelderMead,
+                                           core::OptimizerKind::DifferentialEvolution),
+                         optimizer_name);
+
+/**
+ * @brief 变量投影标定 (网格多起点) 在不同窗口长度上都应找回临界时刻
+ */
+template <core::FloatingPoint T>
+void expect_recovers_critical_time(core::OptimizerKind kind, std::size_t n) {
+    const auto series = lppl_series<T>(n);
+    LPPLCalibrationConfig<T> config;
+    config.optimizer = kind;
+    const auto fit = LPPLCalibrator<T>::calibrate(series.t, series.log_p, series.t_last, config);
+
+    EXPECT_NEAR(fit.tc, series.truth.tc, 1.0) << "n=" << n;
+    EXPECT_NEAR(fit.m, series.truth.m, 0.02) << "n=" << n;
+    EXPECT_NEAR(fit.omega, series.truth.omega, 0.1) << "n=" << n;
+    EXPECT_TRUE(LPPLModel<T>::is_bubble_present(fit));
+    // 残差与噪声水平 (1%) 相当
+    const double sse = LPPLModel<double>::cost_function(series.t.template cast<double>(), series.log_p.template cast<double>(),
+        crash::LPPLParams<double>{fit.A, fit.B, fit.C, fit.tc, fit.m, fit.omega, fit.phi});
+    EXPECT_LT(sse / double(n), 1.2e-4) << "n=" << n;
+}
+
+TEST(LPPLCalibrator, NelderMeadRecoversCriticalTime) {
+    for (const std::size_t n : {250u, 1'000u, 4'000u}) {
+        expect_recovers_critical_time<double>(core::OptimizerKind::NelderMead, n);
+        expect_recovers_critical_time<float>(core::OptimizerKind::NelderMead, n);
+    }
+}
+
+TEST(LPPLCalibrator, DifferentialEvolutionRecoversCriticalTime) {
+    expect_recovers_critical_time<double>(core::OptimizerKind::DifferentialEvolution, 1'000);
+    expect_recovers_critical_time<float>(core::OptimizerKind::DifferentialEvolution, 1'000);
+}
+
+TEST(LPPLCalibrator, StatsIncludeGridEvaluations) {
+    const auto series = lppl_series<double>(500);
+    core::OptimizationStats<double> stats;
+    LPPLCalibrationConfig<double> config;
+    config.optimizer = core::OptimizerKind::NelderMead;
+    config.stats = &stats;
+    LPPLCalibrator<double>::calibrate(series.t, series.log_p, series.t_last, config);
+    EXPECT_EQ(stats.unconverged_runs, 0);
+    // 计数器只在启用遥测 (OPENRISK_TELEMETRY=ON) 时累加
+    if constexpr (core::telemetry_enabled) {
+        EXPECT_GT(stats.objective_evaluations, 180);
+    } else {
+        EXPECT_EQ(stats.objective_evaluations, 0);
+    }
+}
+
+} // namespace
+} // namespace openrisk::test
@@ -0,0 +1,247 @@
+#include "test_common.hpp"
+#include "openrisk/io/columnar.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace openrisk::test {
+namespace {
+
+using io::ColumnarChunk;
+using io::ColumnarWriter;
+using io::MappedColumnarFile;
+
+constexpr std::size_t kTrailerBytes = 40; // magic[8] + version + n_cols + rows + 两个偏移
+
+/**
+ * @brief 测试用临时文件，析构时删除
+ */
+class TempFile {
+public:
+    explicit TempFile(const std::string& name)
+        : path_((std::filesystem::temp_directory_path() / ("openrisk_" + name + ".orc")).string()) {}
+    ~TempFile() { std::filesystem::remove(path_); }
+
+    const std::string& path() const { return path_; }
+
+    std::vector<char> read() const {
+        std::ifstream in(path_, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+    void write(const std::vector<char>& bytes) const {
+        std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+private:
+    std::string path_;
+};
+
+/**
+ * @brief 写入时间戳、3 个 double 列 (收益率面板) 与 1 个 float 列
+ */
+struct ColumnarFixture {
+    std::vector<std::int64_t> timestamps;
+    Eigen::MatrixXd panel;
+    Eigen::VectorXf volume;
+
+    explicit ColumnarFixture(std::size_t rows) : panel(return_panel<double>(rows, 3)) {
+        for (std::size_t i = 0; i < rows; ++i) timestamps.push_back(1'600'000'000'000 + static_cast<std::int64_t>(i) * 60'000);
+        volume = (1e6 * (1.0 + panel.col(0).array().abs())).cast<float>();
+    }
+
+    void write(const std::string& path) const {
+        ColumnarWriter writer(path, timestamps);
+        writer.add_column("a", panel.col(0));
+        writer.add_column("b", panel.col(1));
+        writer.add_column("c", panel.col(2));
+        writer.add_column("volume", volume);
+        writer.close();
+    }
+};
+
+TEST(Columnar, WriteThenReadRoundTrips) {
+    const TempFile file("round_trip");
+    const ColumnarFixture data(1'001);
+    data.write(file.path());
+
+    const MappedColumnarFile mapped(file.path());
+    ASSERT_EQ(mapped.rows(), 1'001u);
+    ASSERT_EQ(mapped.cols(), 4u);
+    EXPECT_EQ(mapped.column_info()[3].name, "volume");
+    EXPECT_EQ(mapped.column_info()[3].type, io::DataType::Float32);
+    for (std::size_t i = 0; i < mapped.rows(); ++i) {
+        ASSERT_EQ(mapped.timestamps()(i), data.timestamps[i]) << "row " << i;
+    }
+    for (Eigen::Index j = 0; j < 3; ++j) {
+        EXPECT_EQ(Eigen::VectorXd(mapped.column<double>(j)), data.panel.col(j)) << "column " << j;
+    }
+    EXPECT_EQ(Eigen::VectorXf(mapped.column<float>("volume")), data.volume);
+    EXPECT_EQ(mapped.column_index("c"), 2u);
+    EXPECT_THROW(mapped.column_index("missing"), std::out_of_range);
+}
+
+TEST(Columnar, AddColumnAcceptsExpressionsAndRejectsWrongLength) {
+    const TempFile file("expressions");
+    const Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(64, 0.0, 1.0);
+    Eigen::MatrixXd wide(2, 64); // 行向量在列主序矩阵中的 inner stride 为 2
+    wide.row(0) = x.transpose();
+    wide.row(1) = -x.transpose();
+    {
+        ColumnarWriter writer(file.path(), std::vector<std::int64_t>(64, 0));
+        writer.add_column("scaled", 2.0 * x);
+        writer.add_column("strided", wide.row(0).transpose());
+        EXPECT_THROW(writer.add_column("short", x.head(63)), std::invalid_argument);
+        writer.close();
+        EXPECT_THROW(writer.add_column("late", x), std::logic_error);
+    }
+    const MappedColumnarFile mapped(file.path());
+    ASSERT_EQ(mapped.cols(), 2u);
+    EXPECT_EQ(Eigen::VectorXd(mapped.column<double>("scaled")), 2.0 * x);
+    EXPECT_EQ(Eigen::VectorXd(mapped.column<double>("strided")), x);
+}
+
+TEST(Columnar, ColumnBlockIsStridedPanel) {
+    const TempFile file("block");
+    // 1'001 行不是 64 字节的整数倍，列间存在填充，块的 outer stride 大于行数
+    const ColumnarFixture data(1'001);
+    data.write(file.path());
+
+    const MappedColumnarFile mapped(file.path());
+    const auto block = mapped.columns<double>(0, 3);
+    EXPECT_EQ(block.rows(), 1'001);
+    EXPECT_EQ(block.cols(), 3);
+    EXPECT_GT(block.outerStride(), block.rows());
+    EXPECT_EQ(block.outerStride() * Eigen::Index(sizeof(double)) % 64, 0);
+    EXPECT_EQ(Eigen::MatrixXd(block), data.panel);
+    EXPECT_EQ(Eigen::MatrixXd(mapped.columns<double>(1, 2)), data.panel.rightCols(2));
+
+    // 跨越 float 列或类型不符都不能构成统一的块
+    EXPECT_THROW(mapped.columns<double>(1, 3), std::invalid_argument);
+    EXPECT_THROW(mapped.columns<float>(0, 2), std::invalid_argument);
+}
+
+TEST(Columnar, ColumnTypeMismatchThrows) {
+    const TempFile file("type_mismatch");
+    ColumnarFixture(100).write(file.path());
+
+    const MappedColumnarFile mapped(file.path());
+    EXPECT_THROW(mapped.column<float>(0), std::invalid_argument);
+    EXPECT_THROW(mapped.column<double>("volume"), std::invalid_argument);
+    EXPECT_THROW(mapped.column<double>(4), std::out_of_range);
+}
+
+TEST(Columnar, ViewsBindToRefsWithoutCopy) {
+    const TempFile file("refs");
+    ColumnarFixture(1'001).write(file.path());
+
+    const MappedColumnarFile mapped(file.path());
+    const auto column = mapped.column<double>(1);
+    const core::ConstVectorRef<double> column_ref(column);
+    EXPECT_EQ(column_ref.data(), column.data());
+
+    const auto block = mapped.columns<double>(0, 3);
+    const core::ConstMatrixRef<double> block_ref(block);
+    EXPECT_EQ(block_ref.data(), block.data());
+    EXPECT_EQ(block_ref.outerStride(), block.outerStride());
+
+    mapped.for_each_chunk(300, [](const ColumnarChunk& chunk) {
+        const auto chunk_column = chunk.column<float>(3);
+        const core::ConstVectorRef<float> chunk_ref(chunk_column);
+        EXPECT_EQ(chunk_ref.data(), chunk_column.data());
+    });
+}
+
+TEST(Columnar, ForEachChunkCoversEveryRowOnce) {
+    const TempFile file("chunks");
+    const ColumnarFixture data(1'001);
+    data.write(file.path());
+    const MappedColumnarFile mapped(file.path());
+
+    // 整除、不整除、大于总行数，以及 0 (整个文件作为一块)
+    for (const std::size_t chunk_rows : {1'001u, 250u, 300u, 4'096u, 0u}) {
+        std::vector<std::size_t> begins;
+        std::size_t covered = 0;
+        mapped.for_each_chunk(chunk_rows, [&](const ColumnarChunk& chunk) {
+            const auto b = static_cast<Eigen::Index>(chunk.begin());
+            const auto n = static_cast<Eigen::Index>(chunk.rows());
+            EXPECT_EQ(chunk.begin(), covered);
+            EXPECT_EQ(chunk.timestamps()(0), data.timestamps[chunk.begin()]);
+            EXPECT_EQ(chunk.timestamps()(n - 1), data.timestamps[chunk.begin() + chunk.rows() - 1]);
+            EXPECT_EQ(Eigen::MatrixXd(chunk.columns<double>(0, 3)), data.panel.middleRows(b, n));
+            EXPECT_EQ(Eigen::VectorXf(chunk.column<float>(3)), data.volume.segment(b, n));
+            begins.push_back(chunk.begin());
+            covered += chunk.rows();
+        });
+        EXPECT_EQ(covered, 1'001u) << "chunk_rows=" << chunk_rows;
+        const std::size_t effective = chunk_rows == 0 ? 1'001 : chunk_rows;
+        EXPECT_EQ(begins.size(), (1'001 + effective - 1) / effective) << "chunk_rows=" << chunk_rows;
+    }
+}
+
+TEST(Columnar, RejectsTruncatedFiles) {
+    const TempFile file("truncated");
+    ColumnarFixture(100).write(file.path());
+    const std::vector<char> bytes = file.read();
+
+    // 小于 trailer：无法映射
+    file.write(std::vector<char>(bytes.end() - kTrailerBytes + 1, bytes.end()));
+    EXPECT_THROW(MappedColumnarFile{file.path()}, std::runtime_error);
+
+    // 截掉数据区开头，trailer 完整但偏移指向文件之外
+    file.write(std::vector<char>(bytes.begin() + 1'024, bytes.end()));
+    EXPECT_THROW(MappedColumnarFile{file.path()}, std::runtime_error);
+
+    // 截掉末尾，trailer 丢失
+    file.write(std::vector<char>(bytes.begin(), bytes.end() - 8));
+    EXPECT_THROW(MappedColumnarFile{file.path()}, std::runtime_error);
+}
+
+TEST(Columnar, RejectsCorruptTrailer) {
+    const TempFile file("corrupt");
+    ColumnarFixture(100).write(file.path());
+    const std::vector<char> bytes = file.read();
+    const std::size_t trailer = bytes.size() - kTrailerBytes;
+
+    std::vector<char> bad_magic = bytes;
+    bad_magic[trailer] = 'X';
+    file.write(bad_magic);
+    EXPECT_THROW(MappedColumnarFile{file.path()}, std::runtime_error);
+
+    std::vector<char> bad_version = bytes;
+    bad_version[trailer + 8] = 2;
+    file.write(bad_version);
+    EXPECT_THROW(MappedColumnarFile{file.path()}, std::runtime_error);
+
+    // directory_offset 指向 trailer 之后
+    std::vector<char> bad_directory = bytes;
+    const std::uint64_t past_end = bytes.size();
+    std::memcpy(bad_directory.data() + trailer + 32, &past_end, sizeof(past_end));
+    file.write(bad_directory);
+    EXPECT_THROW(MappedColumnarFile{file.path()}, std::runtime_error);
+
+    // 行数过大，时间戳块越过目录
+    std::vector<char> bad_rows = bytes;
+    const std::uint64_t huge_rows = std::uint64_t(1) << 60;
+    std::memcpy(bad_rows.data() + trailer + 16, &huge_rows, sizeof(huge_rows));
+    file.write(bad_rows);
+    EXPECT_THROW(MappedColumnarFile{file.path()}, std::runtime_error);
+
+    // 列数多于目录项
+    std::vector<char> bad_cols = bytes;
+    const std::uint32_t n_cols = 1'000;
+    std::memcpy(bad_cols.data() + trailer + 12, &n_cols, sizeof(n_cols));
+    file.write(bad_cols);
+    EXPECT_THROW(MappedColumnarFile{file.path()}, std::runtime_error);
+
+    // 未改动的文件仍可读取
+    file.write(bytes);
+    EXPECT_NO_THROW(MappedColumnarFile{file.path()});
+}
+
+} // namespace
+} // namespace openrisk::test
@@ -0,0 +1,19 @@
+#include "test_common.hpp"
+#include "openrisk/crash/lppl.hpp"
+
+namespace openrisk::test {
+namespace {
+
+using crash::LPPLModel;
+
+TEST(LPPLModel, CostFunctionFloatMatchesDouble) {
+    const auto series = lppl_series<double>(10'000);
+    const auto& p = series.truth;
+    const double reference = LPPLModel<double>::cost_function(series.t, series.log_p, p);
+    const double value = LPPLModel<float>::cost_function(series.t.cast<float>(), series.log_p.cast<float>(),
+        crash::LPPLParams<float>{float(p.A), float(p.B), float(p.C), float(p.tc), float(p.m), float(p.omega), float(p.phi)});
+    EXPECT_TRUE(relatively_near(value, reference, 1e-3));
+}
+
+} // namespace
+} // namespace openrisk::test
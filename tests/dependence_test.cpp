@@ -0,0 +1,53 @@
+#include "test_common.hpp"
+#include "openrisk/dependence/correlation.hpp"
+
+namespace openrisk::test {
+namespace {
+
+using dependence::Correlation;
+
+TEST(Correlation, KnownValues) {
+    Eigen::VectorXd x(5);
+    Eigen::VectorXd y(5);
+    x << 1, 2, 3, 4, 5;
+    y << 2, 1, 4, 3, 5;
+    // 10 对中 8 对同序、2 对逆序
+    EXPECT_DOUBLE_EQ(Correlation<double>::kendall_tau(x, y), 0.6);
+    // 秩差平方和为 4：1 - 6 * 4 / (5 * 24)
+    EXPECT_NEAR(Correlation<double>::spearman(x, y), 0.8, 1e-15);
+    EXPECT_NEAR(Correlation<double>::pearson(x, y), 0.8, 1e-15);
+}
+
+TEST(Correlation, RankMeasuresAreInvariantToMonotoneTransforms) {
+    const auto panel = return_panel<double>(2'000, 2);
+    const Eigen::VectorXd x = panel.col(0);
+    const Eigen::VectorXd y = panel.col(1);
+    const Eigen::VectorXd y_exp = (100 * y).array().exp();
+    EXPECT_DOUBLE_EQ(Correlation<double>::spearman(x, y), Correlation<double>::spearman(x, y_exp));
+    EXPECT_DOUBLE_EQ(Correlation<double>::kendall_tau(x, y), Correlation<double>::kendall_tau(x, y_exp));
+    EXPECT_NEAR(Correlation<double>::pearson(x, x), 1.0, 1e-12);
+    EXPECT_NEAR(Correlation<double>::pearson(x, -x), -1.0, 1e-12);
+}
+
+TEST(Correlation, FloatMatchesDouble) {
+    const auto panel = return_panel<double>(5'000, 2);
+    const Eigen::VectorXf x = panel.col(0).cast<float>();
+    const Eigen::VectorXf y = panel.col(1).cast<float>();
+    EXPECT_TRUE(relatively_near(Correlation<float>::pearson(x, y), Correlation<double>::pearson(panel.col(0), panel.col(1)), 1e-5));
+    EXPECT_TRUE(relatively_near(Correlation<float>::spearman(x, y), Correlation<double>::spearman(panel.col(0), panel.col(1)), 1e-5));
+    EXPECT_TRUE(relatively_near(Correlation<float>::kendall_tau(x, y), Correlation<double>::kendall_tau(panel.col(0), panel.col(1)), 1e-5));
+}
+
+TEST(Correlation, RankTransformChecksOutputLength) {
+    Eigen::VectorXd x(4);
+    x << 0.3, -1.0, 2.0, 0.1;
+    Eigen::VectorXd ranks(4);
+    Correlation<double>::rank_transform(x, ranks);
+    EXPECT_EQ(ranks, Eigen::Vector4d(3, 1, 4, 2));
+
+    Eigen::VectorXd short_ranks(3);
+    EXPECT_THROW(Correlation<double>::rank_transform(x, short_ranks), std::invalid_argument);
+}
+
+} // namespace
+} // namespace openrisk::test
@@ -0,0 +1,47 @@
+#include "test_common.hpp"
+#include "openrisk/factor/covariance.hpp"
+
+namespace openrisk::test {
+namespace {
+
+using factor::CovarianceEstimator;
+
+TEST(CovarianceEstimator, SampleCovarianceMatchesDefinition) {
+    const auto returns = return_panel<double>(500, 6);
+    const Eigen::MatrixXd centered = returns.rowwise() - returns.colwise().mean();
+    const Eigen::MatrixXd reference = centered.transpose() * centered / double(returns.rows() - 1);
+    EXPECT_TRUE(relatively_near<double>(CovarianceEstimator<double>::sample_covariance(returns), reference, 1e-12));
+}
+
+TEST(CovarianceEstimator, SampleCovarianceFloatMatchesDouble) {
+    const auto returns = return_panel<double>(100'000, 8);
+    const Eigen::MatrixXd reference = CovarianceEstimator<double>::sample_covariance(returns);
+    const Eigen::MatrixXf value = CovarianceEstimator<float>::sample_covariance(returns.cast<float>());
+    EXPECT_TRUE(relatively_near(value, reference, 1e-5));
+}
+
+TEST(CovarianceEstimator, OutputOverloadMatchesReturningOverload) {
+    const auto returns = return_panel<float>(1'000, 5);
+    Eigen::MatrixXf cov(5, 5);
+    CovarianceEstimator<float>::sample_covariance(returns, cov);
+    EXPECT_TRUE(relatively_near(cov, CovarianceEstimator<float>::sample_covariance(returns).cast<double>(), 0));
+
+    Eigen::MatrixXf wrong(5, 4);
+    EXPECT_THROW(CovarianceEstimator<float>::sample_covariance(returns, wrong), std::invalid_argument);
+}
+
+TEST(CovarianceEstimator, LedoitWolfFloatMatchesDouble) {
+    const auto returns = return_panel<double>(20'000, 10);
+    const Eigen::MatrixXd reference = CovarianceEstimator<double>::ledoit_wolf_shrinkage(returns);
+    const Eigen::MatrixXf value = CovarianceEstimator<float>::ledoit_wolf_shrinkage(returns.cast<float>());
+    EXPECT_TRUE(relatively_near(value, reference, 1e-5));
+
+    // 收缩后仍为对称正定矩阵，对角线即样本方差
+    EXPECT_TRUE(reference.isApprox(reference.transpose()));
+    EXPECT_EQ(reference.llt().info(), Eigen::Success);
+    EXPECT_TRUE(relatively_near<double>(reference.diagonal(),
+                                        CovarianceEstimator<double>::sample_covariance(returns).diagonal(), 1e-12));
+}
+
+} // namespace
+} // namespace openrisk::test
@@ -0,0 +1,233 @@
+#include "test_common.hpp"
+#include "openrisk/core/stats.hpp"
+#include "openrisk/time_series/garch.hpp"
+#include <boost/math/distributions/students_t.hpp>
+#include <boost/math/quadrature/gauss_kronrod.hpp>
+#include <numbers>
+#include <random>
+
+namespace openrisk::test {
+namespace {
+
+using time_series::GarchCalibrationConfig;
+using time_series::GarchModel;
+using time_series::GarchParams;
+using time_series::GarchVariant;
+using time_series::Innovation;
+
+/**
+ * @brief 单位方差新息的密度：正态直接按公式，Student-t 取 boost 的标准 t 密度并缩放到单位方差
+ */
+template <Innovation I>
+double innovation_pdf(double z, double nu) {
+    if constexpr (I == Innovation::Gaussian) {
+        return std::exp(-0.5 * z * z) / std::sqrt(2 * std::numbers::pi);
+    } else {
+        const double scale = std::sqrt(nu / (nu - 2));
+        return boost::math::pdf(boost::math::students_t_distribution<double>(nu), z * scale) * scale;
+    }
+}
+
+/**
+ * @brief E|z|，对上面的密度做数值积分，与库中的闭式结果相互独立
+ * 代换 z = u / (1 - u) 把 [0, inf) 映射到 [0, 1)，不截断 Student-t 的厚尾
+ */
+template <Innovation I>
+double abs_mean(double nu) {
+    auto integrand = [&](double u) {
+        const double z = u / (1 - u);
+        return 2 * z * innovation_pdf<I>(z, nu) / ((1 - u) * (1 - u));
+    };
+    return boost::math::quadrature::gauss_kronrod<double, 61>::integrate(integrand, 0.0, 1.0, 20, 1e-14);
+}
+
+/**
+ * @brief 条件方差的逐项递推，按各变体的定义式直接写出
+ */
+template <GarchVariant V>
+double next_variance(double sigma_sq, double r, const GarchParams<double>& p, double e_abs_z) {
+    if constexpr (V == GarchVariant::Symmetric) {
+        return p.omega + p.alpha * r * r + p.beta * sigma_sq;
+    } else if constexpr (V == GarchVariant::GJR) {
+        return p.omega + (p.alpha + (r < 0 ? p.gamma : 0.0)) * r * r + p.beta * sigma_sq;
+    } else {
+        const double z = r / std::sqrt(sigma_sq);
+        return std::exp(p.omega + p.alpha * (std::abs(z) - e_abs_z) + p.gamma * z + p.beta * std::log(sigma_sq));
+    }
+}
+
+/**
+ * @brief 按模型模拟收益率：新息为单位方差正态或 Student-t，前 1'000 步作为预热丢弃
+ */
+template <GarchVariant V, Innovation I>
+Eigen::VectorXd simulate(std::size_t n, const GarchParams<double>& p, uint32_t seed = 42) {
+    std::mt19937_64 engine(seed);
+    std::normal_distribution<double> normal;
+    std::student_t_distribution<double> student(I == Innovation::StudentT ? p.nu : 10.0);
+    const double t_scale = I == Innovation::StudentT ? std::sqrt((p.nu - 2) / p.nu) : 1.0;
+    const double e_abs_z = V == GarchVariant::EGARCH ? abs_mean<I>(p.nu) : 0.0;
+
+    const std::size_t burn_in = 1'000;
+    Eigen::VectorXd r(n);
+    double sigma_sq = 1e-4;
+    for (std::size_t t = 0; t < n + burn_in; ++t) {
+        const double z = I == Innovation::StudentT ? t_scale * student(engine) : normal(engine);
+        const double r_t = std::sqrt(sigma_sq) * z;
+        if (t >= burn_in) r(t - burn_in) = r_t;
+        sigma_sq = next_variance<V>(sigma_sq, r_t, p, e_abs_z);
+    }
+    return r;
+}
+
+/**
+ * @brief filter 与负对数似然和逐项求和一致：方差按定义式递推 (初值为 r^2 的均值)，
+ * 对数密度取 log(pdf(r / sigma) / sigma)
+ */
+template <GarchVariant V, Innovation I>
+void expect_log_likelihood_matches_direct_sum(const GarchParams<double>& params) {
+    const auto returns = garch_returns<double>(2'000);
+    const double e_abs_z = V == GarchVariant::EGARCH ? abs_mean<I>(params.nu) : 0.0;
+
+    Eigen::VectorXd sigmas_sq(returns.size());
+    sigmas_sq(0) = returns.squaredNorm() / double(returns.size());
+    for (Eigen::Index t = 1; t < returns.size(); ++t) {
+        sigmas_sq(t) = next_variance<V>(sigmas_sq(t - 1), returns(t - 1), params, e_abs_z);
+    }
+    double log_lik = 0;
+    for (Eigen::Index t = 0; t < returns.size(); ++t) {
+        const double sigma = std::sqrt(sigmas_sq(t));
+        log_lik += std::log(innovation_pdf<I>(returns(t) / sigma, params.nu) / sigma);
+    }
+
+    using Model = GarchModel<double, V, I>;
+    // EGARCH 的 E|z| 误差经 1 / (1 - beta) 放大，数值积分的精度决定了这里的容差
+    EXPECT_TRUE(relatively_near<double>(Model::filter(returns, params), sigmas_sq, 1e-10));
+    EXPECT_TRUE(relatively_near(Model::log_likelihood(returns, params), -log_lik, 1e-12));
+}
+
+TEST(GarchVariantLogLikelihood, SymmetricStudentTMatchesBoostDensity) {
+    expect_log_likelihood_matches_direct_sum<GarchVariant::Symmetric, Innovation::StudentT>({2e-6, 0.08, 0.9, 0, 5.0});
+}
+
+TEST(GarchVariantLogLikelihood, GjrGaussianMatchesDirectSum) {
+    expect_log_likelihood_matches_direct_sum<GarchVariant::GJR, Innovation::Gaussian>({2e-6, 0.03, 0.88, 0.12});
+}
+
+TEST(GarchVariantLogLikelihood, GjrStudentTMatchesDirectSum) {
+    expect_log_likelihood_matches_direct_sum<GarchVariant::GJR, Innovation::StudentT>({2e-6, 0.03, 0.88, 0.12, 7.0});
+}
+
+TEST(GarchVariantLogLikelihood, EGarchGaussianMatchesDirectSum) {
+    // E|z| = sqrt(2 / pi) 由数值积分得到
+    expect_log_likelihood_matches_direct_sum<GarchVariant::EGARCH, Innovation::Gaussian>({-0.2, 0.15, 0.98, -0.08});
+}
+
+TEST(GarchVariantLogLikelihood, EGarchStudentTMatchesDirectSum) {
+    // 单位方差 Student-t 的 E|z| 由 boost 密度数值积分得到
+    for (const double nu : {3.0, 5.0, 30.0}) {
+        expect_log_likelihood_matches_direct_sum<GarchVariant::EGARCH, Innovation::StudentT>({-0.2, 0.15, 0.98, -0.08, nu});
+    }
+}
+
+/**
+ * @brief 在模型自身模拟的数据上标定，找回杠杆项 gamma 与自由度 nu
+ */
+template <GarchVariant V, Innovation I>
+void expect_recovers(const GarchParams<double>& truth, double gamma_tol, double nu_tol) {
+    const auto returns = simulate<V, I>(20'000, truth);
+    GarchCalibrationConfig<double> config;
+    config.variant = V;
+    config.innovation = I;
+    core::OptimizationStats<double> stats;
+    config.stats = &stats;
+    const auto fit = time_series::calibrate_garch<double>(returns, config);
+
+    EXPECT_EQ(stats.unconverged_runs, 0);
+    EXPECT_NEAR(fit.beta, truth.beta, 0.03);
+    if constexpr (V != GarchVariant::Symmetric) EXPECT_NEAR(fit.gamma, truth.gamma, gamma_tol);
+    if constexpr (I == Innovation::StudentT) EXPECT_NEAR(fit.nu, truth.nu, nu_tol);
+    // 拟合点的似然不差于真值
+    using Model = GarchModel<double, V, I>;
+    EXPECT_LE(Model::log_likelihood(returns, fit), Model::log_likelihood(returns, truth) + 1e-6);
+}
+
+TEST(GarchVariantCalibration, SymmetricStudentTRecoversNu) {
+    expect_recovers<GarchVariant::Symmetric, Innovation::StudentT>({2e-6, 0.08, 0.9, 0, 6.0}, 0, 1.5);
+}
+
+TEST(GarchVariantCalibration, GjrGaussianRecoversGamma) {
+    expect_recovers<GarchVariant::GJR, Innovation::Gaussian>({2e-6, 0.03, 0.9, 0.1}, 0.03, 0);
+}
+
+TEST(GarchVariantCalibration, GjrStudentTRecoversGammaAndNu) {
+    expect_recovers<GarchVariant::GJR, Innovation::StudentT>({2e-6, 0.03, 0.9, 0.1, 6.0}, 0.03, 1.5);
+}
+
+TEST(GarchVariantCalibration, EGarchGaussianRecoversGamma) {
+    expect_recovers<GarchVariant::EGARCH, Innovation::Gaussian>({-0.18, 0.15, 0.98, -0.08}, 0.03, 0);
+}
+
+TEST(GarchVariantCalibration, EGarchStudentTRecoversGammaAndNu) {
+    expect_recovers<GarchVariant::EGARCH, Innovation::StudentT>({-0.18, 0.15, 0.98, -0.08, 6.0}, 0.03, 1.5);
+}
+
+/**
+ * @brief 各变体的默认引擎 (L-BFGS，未收敛时转 Nelder-Mead) 与 Nelder-Mead 达到相同的似然
+ */
+template <GarchVariant V, Innovation I>
+void expect_default_matches_nelder_mead() {
+    Eigen::MatrixXd panel(1'000, 4);
+    for (int j = 0; j < 4; ++j) panel.col(j) = garch_returns<double>(1'000, 100 + j);
+
+    GarchCalibrationConfig<double> config;
+    config.variant = V;
+    config.innovation = I;
+    core::OptimizationStats<double> stats;
+    config.stats = &stats;
+    const auto fit = time_series::calibrate_garch_panel<double>(panel, config);
+    EXPECT_EQ(stats.unconverged_runs, 0);
+
+    config.optimizer = core::OptimizerKind::NelderMead;
+    const auto reference = time_series::calibrate_garch_panel<double>(panel, config);
+
+    const Eigen::VectorXd nll = GarchModel<double, V, I>::log_likelihood_panel(panel, fit);
+    const Eigen::VectorXd reference_nll = GarchModel<double, V, I>::log_likelihood_panel(panel, reference);
+    for (int j = 0; j < 4; ++j) {
+        EXPECT_LE(nll(j), reference_nll(j) + 0.1) << "column " << j;
+    }
+}
+
+TEST(GarchVariantCalibration, SymmetricStudentT) { expect_default_matches_nelder_mead<GarchVariant::Symmetric, Innovation::StudentT>(); }
+TEST(GarchVariantCalibration, GjrGaussian) { expect_default_matches_nelder_mead<GarchVariant::GJR, Innovation::Gaussian>(); }
+TEST(GarchVariantCalibration, GjrStudentT) { expect_default_matches_nelder_mead<GarchVariant::GJR, Innovation::StudentT>(); }
+TEST(GarchVariantCalibration, EGarchGaussian) { expect_default_matches_nelder_mead<GarchVariant::EGARCH, Innovation::Gaussian>(); }
+TEST(GarchVariantCalibration, EGarchStudentT) { expect_default_matches_nelder_mead<GarchVariant::EGARCH, Innovation::StudentT>(); }
+
+/**
+ * @brief 少于 5 个观测时不标定，返回各变体自己的默认参数
+ */
+TEST(GarchVariantCalibration, ShortSampleFallbackIsVariantSpecific) {
+    Eigen::VectorXd returns(4);
+    returns << 0.01, -0.02, 0.015, -0.005;
+    GarchCalibrationConfig<double> config;
+    config.variant = GarchVariant::EGARCH;
+    const auto egarch = time_series::calibrate_garch<double>(returns, config);
+    // 无条件 log 方差 omega / (1 - beta) 等于样本 log 方差
+    EXPECT_NEAR(egarch.omega / (1 - egarch.beta), std::log(core::Statistics<double>::variance(returns)), 1e-12);
+    EXPECT_EQ(egarch.nu, 0);
+    const Eigen::VectorXd sigmas_sq = GarchModel<double, GarchVariant::EGARCH>::filter(returns, egarch);
+    EXPECT_TRUE(sigmas_sq.allFinite());
+    EXPECT_LT(sigmas_sq.maxCoeff(), 1e-2);
+
+    config.innovation = Innovation::StudentT;
+    EXPECT_GT(time_series::calibrate_garch<double>(returns.head(1), config).nu, 2);
+    EXPECT_LT(time_series::calibrate_garch<double>(returns.head(1), config).omega, 0);
+
+    config.variant = GarchVariant::GJR;
+    const auto gjr = time_series::calibrate_garch<double>(returns, config);
+    EXPECT_GT(gjr.omega, 0);
+    EXPECT_LT(gjr.alpha + gjr.gamma / 2 + gjr.beta, 1);
+}
+
+} // namespace
+} // namespace openrisk::test
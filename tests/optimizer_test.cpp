@@ -0,0 +1,172 @@
+#include "test_common.hpp"
+#include "openrisk/core/differential_evolution.hpp"
+#include "openrisk/core/lbfgs.hpp"
+#include "openrisk/core/nelder_mead.hpp"
+#include <atomic>
+
+namespace openrisk::test {
+namespace {
+
+using core::IterationRecord;
+using core::OptimizationObserver;
+using core::OptimizerKind;
+
+/**
+ * @brief 二维 Rosenbrock 函数，记录实际调用次数 (差分进化并行评估，计数须为原子操作)
+ */
+struct Rosenbrock {
+    std::atomic<long>* calls;
+
+    double operator()(const Eigen::VectorXd& x) const {
+        calls->fetch_add(1, std::memory_order_relaxed);
+        const double a = 1.0 - x(0);
+        const double b = x(1) - x(0) * x(0);
+        return a * a + 100.0 * b * b;
+    }
+};
+
+const Eigen::VectorXd kStart = Eigen::Vector2d(-1.2, 1.0);
+const Eigen::VectorXd kLower = Eigen::VectorXd::Constant(2, -5.0);
+const Eigen::VectorXd kUpper = Eigen::VectorXd::Constant(2, 5.0);
+
+/**
+ * @brief 在第 stop_after 次回调时要求终止
+ */
+class StopAfter : public OptimizationObserver<double> {
+public:
+    explicit StopAfter(int stop_after) : stop_after_(stop_after) {}
+
+    bool on_iteration(const IterationRecord<double>& record) override {
+        iterations.push_back(record.iteration);
+        return static_cast<int>(iterations.size()) < stop_after_;
+    }
+
+    std::vector<int> iterations;
+
+private:
+    int stop_after_;
+};
+
+class OptimizerTelemetry : public ::testing::TestWithParam<OptimizerKind> {};
+
+TEST_P(OptimizerTelemetry, CountsEveryObjectiveEvaluation) {
+    std::atomic<long> calls = 0;
+    auto optimizer = core::make_optimizer<double>(GetParam(), 2);
+    const auto res = optimizer->minimize(Rosenbrock{&calls}, kStart, kLower, kUpper);
+
+    EXPECT_TRUE(res.converged);
+    EXPECT_EQ(res.stats.unconverged_runs, 0);
+    EXPECT_NEAR(res.x_best(0), 1.0, 1e-2);
+    if constexpr (core::telemetry_enabled) {
+        EXPECT_EQ(res.stats.objective_evaluations, calls.load());
+    } else {
+        EXPECT_EQ(res.stats.objective_evaluations, 0);
+    }
+}
+
+TEST_P(OptimizerTelemetry, TrajectoryHasOneRecordPerIteration) {
+    std::atomic<long> calls = 0;
+    auto optimizer = core::make_optimizer<double>(GetParam(), 2);
+    optimizer->set_record_trajectory(true);
+    const auto res = optimizer->minimize(Rosenbrock{&calls}, kStart, kLower, kUpper);
+
+    ASSERT_GT(res.iterations, 0);
+    if constexpr (core::telemetry_enabled) {
+        ASSERT_EQ(res.stats.trajectory.size(), static_cast<std::size_t>(res.iterations));
+        for (int i = 0; i < res.iterations; ++i) EXPECT_EQ(res.stats.trajectory[i].iteration, i);
+        EXPECT_EQ(res.stats.trajectory.back().value, res.min_value);
+    } else {
+        EXPECT_TRUE(res.stats.trajectory.empty());
+    }
+}
+
+TEST_P(OptimizerTelemetry, ObserverReturningFalseStopsTheRun) {
+    std::atomic<long> calls = 0;
+    auto optimizer = core::make_optimizer<double>(GetParam(), 2);
+    StopAfter observer(3);
+    optimizer->set_observer(&observer);
+    optimizer->set_record_trajectory(true);
+    const auto res = optimizer->minimize(Rosenbrock{&calls}, kStart, kLower, kUpper);
+
+    // 回调不受遥测开关影响
+    EXPECT_EQ(observer.iterations, (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(res.iterations, 3);
+    EXPECT_FALSE(res.converged);
+    EXPECT_EQ(res.stats.unconverged_runs, 1);
+    if constexpr (core::telemetry_enabled) EXPECT_EQ(res.stats.trajectory.size(), 3u);
+
+    // 取消回调后完整运行
+    optimizer->set_observer(nullptr);
+    EXPECT_GT(optimizer->minimize(Rosenbrock{&calls}, kStart, kLower, kUpper).iterations, 3);
+}
+
+TEST_P(OptimizerTelemetry, EmptyParameterVectorEvaluatesOnce) {
+    std::atomic<long> calls = 0;
+    auto optimizer = core::make_optimizer<double>(GetParam(), 2);
+    const auto res = optimizer->minimize([&](const Eigen::VectorXd&) { ++calls; return 3.0; },
+                                         Eigen::VectorXd(), Eigen::VectorXd(), Eigen::VectorXd());
+
+    EXPECT_TRUE(res.converged);
+    EXPECT_EQ(res.iterations, 0);
+    EXPECT_EQ(res.x_best.size(), 0);
+    EXPECT_EQ(res.min_value, 3.0);
+    EXPECT_EQ(res.stats.unconverged_runs, 0);
+    // L-BFGS 另外做一次 (零维) 梯度估计，不会再调用目标函数
+    EXPECT_EQ(calls.load(), 1);
+}
+
+INSTANTIATE_TEST_SUITE_P(Optimizers, OptimizerTelemetry,
+                         ::testing::Values(OptimizerKind::LBFGS, OptimizerKind::NelderMead,
+                                           OptimizerKind::DifferentialEvolution),
+                         optimizer_name);
+
+TEST(LBFGSOptimizer, EvaluationsAreGradientsPlusLineSearch) {
+    if constexpr (!core::telemetry_enabled) GTEST_SKIP() << "telemetry disabled";
+    std::atomic<long> calls = 0;
+    core::LBFGSOptimizer<double> optimizer;
+    const auto res = optimizer.minimize(Rosenbrock{&calls}, kStart, kLower, kUpper);
+    const auto& stats = res.stats;
+
+    // 每次梯度 2n 次中心差分；每次线搜索试探一次，成功的线搜索后紧跟一次梯度，
+    // 再加上初始点的一次评估：evals = 2n * G + (G - 1) + backtracks + 1
+    EXPECT_GT(stats.gradient_evaluations, res.iterations);
+    EXPECT_GT(stats.line_search_backtracks, 0);
+    EXPECT_EQ(stats.objective_evaluations, 4 * stats.gradient_evaluations + stats.gradient_evaluations +
+                                               stats.line_search_backtracks);
+    EXPECT_EQ(stats.objective_evaluations, calls.load());
+    EXPECT_GT(stats.gradient_seconds, 0.0);
+}
+
+TEST(LBFGSOptimizer, ConvergedStartReportsZeroIterations) {
+    std::atomic<long> calls = 0;
+    core::LBFGSOptimizer<double> optimizer;
+    StopAfter observer(1);
+    optimizer.set_observer(&observer);
+    optimizer.set_record_trajectory(true);
+    const auto res = optimizer.minimize(Rosenbrock{&calls}, Eigen::Vector2d(1.0, 1.0), kLower, kUpper);
+
+    EXPECT_TRUE(res.converged);
+    EXPECT_EQ(res.iterations, 0);
+    EXPECT_TRUE(observer.iterations.empty());
+    EXPECT_TRUE(res.stats.trajectory.empty());
+    EXPECT_EQ(res.stats.line_search_backtracks, 0);
+    if constexpr (core::telemetry_enabled) EXPECT_EQ(res.stats.gradient_evaluations, 1);
+}
+
+TEST(NelderMeadOptimizer, ConvergedStartReportsZeroIterations) {
+    std::atomic<long> calls = 0;
+    core::NelderMeadOptimizer<double>::Config config;
+    config.f_tol = 10.0;
+    config.x_tol = 1.0; // 初始单纯形已满足收敛判据
+    core::NelderMeadOptimizer<double> optimizer(config);
+    optimizer.set_record_trajectory(true);
+    const auto res = optimizer.minimize(Rosenbrock{&calls}, Eigen::Vector2d(1.0, 1.0), kLower, kUpper);
+
+    EXPECT_TRUE(res.converged);
+    EXPECT_EQ(res.iterations, 0);
+    EXPECT_TRUE(res.stats.trajectory.empty());
+    if constexpr (core::telemetry_enabled) EXPECT_EQ(res.stats.objective_evaluations, 3);
+}
+
+} // namespace
+} // namespace openrisk::test
@@ -0,0 +1,157 @@
+#include "test_common.hpp"
+#include "openrisk/factor/portfolio_risk.hpp"
+#include "../src/factor/attribution.hpp"
+
+namespace openrisk::test {
+namespace {
+
+using factor::PortfolioRisk;
+using factor::RiskAttribution;
+using factor::TradeProposal;
+
+/**
+ * @brief N 个资产、K 个因子的随机因子模型
+ */
+struct FactorModel {
+    Eigen::MatrixXd beta;
+    Eigen::MatrixXd factor_cov;
+    Eigen::VectorXd specific_var;
+    Eigen::VectorXd weights;
+
+    Eigen::MatrixXd full_covariance() const {
+        Eigen::MatrixXd sigma = beta * factor_cov * beta.transpose();
+        sigma.diagonal() += specific_var;
+        return sigma;
+    }
+
+    double variance(const Eigen::VectorXd& w) const {
+        return RiskAttribution<double>::total_variance(w, beta, factor_cov, specific_var);
+    }
+};
+
+FactorModel factor_model(Eigen::Index n, Eigen::Index k, uint32_t seed = 42) {
+    core::RandomEngine<double> rng(seed);
+    FactorModel m;
+    m.beta = Eigen::MatrixXd(n, k);
+    for (Eigen::Index f = 0; f < k; ++f) m.beta.col(f) = rng.next_normal_vector(n);
+    Eigen::MatrixXd a(k, k);
+    for (Eigen::Index f = 0; f < k; ++f) a.col(f) = 0.01 * rng.next_normal_vector(k);
+    m.factor_cov = a * a.transpose() + 1e-4 * Eigen::MatrixXd::Identity(k, k);
+    m.specific_var = 1e-4 * (1.0 + rng.next_normal_vector(n).array().abs());
+    m.weights = Eigen::VectorXd::Constant(n, 1.0 / double(n)) + 0.001 * rng.next_normal_vector(n);
+    return m;
+}
+
+/**
+ * @brief 在 n 个资产中随机抽取 size 笔调仓，资产只从前 distinct 个中选，从而产生重复
+ */
+TradeProposal<double> random_trade(Eigen::Index n, std::size_t size, Eigen::Index distinct, uint32_t seed) {
+    core::RandomEngine<double> rng(seed);
+    TradeProposal<double> trade;
+    for (std::size_t j = 0; j < size; ++j) {
+        trade.assets.push_back(static_cast<Eigen::Index>(rng.next_uniform() * double(std::min(n, distinct))));
+        trade.deltas.push_back(0.01 * (rng.next_uniform() - 0.5));
+    }
+    return trade;
+}
+
+Eigen::VectorXd traded_weights(const Eigen::VectorXd& w, const TradeProposal<double>& trade) {
+    Eigen::VectorXd out = w;
+    for (std::size_t j = 0; j < trade.assets.size(); ++j) out(trade.assets[j]) += trade.deltas[j];
+    return out;
+}
+
+TEST(PortfolioRisk, VarianceMatchesFullRecompute) {
+    const auto m = factor_model(200, 8);
+    const PortfolioRisk<double> risk(m.beta, m.factor_cov, m.specific_var, m.weights);
+    EXPECT_TRUE(relatively_near(risk.variance(), m.variance(m.weights), 1e-12));
+}
+
+TEST(PortfolioRisk, WhatIfMatchesFullRecomputeWithRepeatedAssets) {
+    const auto m = factor_model(200, 8);
+    const PortfolioRisk<double> risk(m.beta, m.factor_cov, m.specific_var, m.weights);
+    // 小提案走逐项扫描 (<= 64)，大提案走排序分组；两者都让资产重复出现
+    for (const std::size_t size : {1u, 5u, 64u, 65u, 500u}) {
+        const auto trade = random_trade(200, size, 20, static_cast<uint32_t>(size));
+        EXPECT_TRUE(relatively_near(risk.what_if_variance(trade), m.variance(traded_weights(m.weights, trade)), 1e-10))
+            << "size=" << size;
+    }
+}
+
+TEST(PortfolioRisk, ApplyThenVarianceMatchesFullRecompute) {
+    const auto m = factor_model(200, 8);
+    PortfolioRisk<double> risk(m.beta, m.factor_cov, m.specific_var, m.weights);
+    Eigen::VectorXd w = m.weights;
+    for (uint32_t s = 0; s < 20; ++s) {
+        const auto trade = random_trade(200, 10 + s * 7, 30, 1000 + s);
+        const double predicted = risk.what_if_variance(trade);
+        risk.apply(trade);
+        w = traded_weights(w, trade);
+        EXPECT_TRUE(relatively_near(risk.variance(), predicted, 1e-12));
+        EXPECT_TRUE(relatively_near(risk.variance(), m.variance(w), 1e-10));
+    }
+    EXPECT_TRUE(relatively_near<double>(risk.weights(), w, 1e-14));
+
+    const double incremental = risk.variance();
+    risk.rebase();
+    EXPECT_TRUE(relatively_near(risk.variance(), incremental, 1e-12));
+}
+
+TEST(PortfolioRisk, MarginalContributionMatchesFullMctr) {
+    const auto m = factor_model(100, 5);
+    const PortfolioRisk<double> risk(m.beta, m.factor_cov, m.specific_var, m.weights);
+    const Eigen::VectorXd reference =
+        RiskAttribution<double>::marginal_contribution_to_risk(m.weights, m.full_covariance());
+
+    EXPECT_TRUE(relatively_near<double>(risk.marginal_contribution_to_risk(), reference, 1e-12));
+    for (Eigen::Index i = 0; i < 100; ++i) {
+        EXPECT_NEAR(risk.marginal_contribution(i), reference(i), 1e-12 * reference.norm()) << "asset " << i;
+    }
+
+    Eigen::VectorXd short_mctr(99);
+    EXPECT_THROW(RiskAttribution<double>::marginal_contribution_to_risk(m.weights, m.full_covariance(), short_mctr),
+                 std::invalid_argument);
+}
+
+TEST(PortfolioRisk, InvalidTradesThrowWithoutChangingState) {
+    const auto m = factor_model(50, 4);
+    PortfolioRisk<double> risk(m.beta, m.factor_cov, m.specific_var, m.weights);
+    const double variance = risk.variance();
+
+    // 越界下标出现在合法调仓之后，也不能留下部分更新
+    const TradeProposal<double> out_of_range{{3, 50}, {0.01, 0.01}};
+    const TradeProposal<double> negative{{-1}, {0.01}};
+    const TradeProposal<double> mismatched{{1, 2}, {0.01}};
+    EXPECT_THROW(risk.apply(out_of_range), std::out_of_range);
+    EXPECT_THROW(risk.apply(negative), std::out_of_range);
+    EXPECT_THROW(risk.apply(mismatched), std::invalid_argument);
+    EXPECT_THROW(risk.what_if_variance(out_of_range), std::out_of_range);
+    EXPECT_THROW(risk.what_if_variance(mismatched), std::invalid_argument);
+    EXPECT_THROW(risk.what_if_variance(std::vector<TradeProposal<double>>(300, out_of_range)), std::out_of_range);
+
+    EXPECT_EQ(risk.variance(), variance);
+    EXPECT_EQ(risk.weights(), m.weights);
+    EXPECT_THROW(PortfolioRisk<double>(m.beta, m.factor_cov, m.specific_var, m.weights.head(49)), std::invalid_argument);
+}
+
+TEST(PortfolioRisk, BatchMatchesSingleTrade) {
+    const auto m = factor_model(200, 8);
+    const PortfolioRisk<double> risk(m.beta, m.factor_cov, m.specific_var, m.weights);
+    std::vector<TradeProposal<double>> trades;
+    for (uint32_t s = 0; s < 1'000; ++s) trades.push_back(random_trade(200, 1 + s % 80, 40, s));
+
+    core::WorkerPool pool(4);
+    const Eigen::VectorXd batch = risk.what_if_variance(trades);
+    const Eigen::VectorXd pooled = risk.what_if_variance(trades, pool);
+    ASSERT_EQ(batch.size(), 1'000);
+    ASSERT_EQ(pooled.size(), 1'000);
+    for (std::size_t c = 0; c < trades.size(); ++c) {
+        EXPECT_EQ(batch(c), risk.what_if_variance(trades[c])) << "trade " << c;
+        EXPECT_EQ(pooled(c), batch(c)) << "trade " << c;
+    }
+    // 同一个 pool 可以反复使用
+    EXPECT_EQ(risk.what_if_variance(trades, pool), pooled);
+}
+
+} // namespace
+} // namespace openrisk::test
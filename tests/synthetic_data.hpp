@@ -0,0 +1,69 @@
+#pragma once
+#include "openrisk/core/random.hpp"
+#include "openrisk/crash/lppl.hpp"
+#include <cmath>
+
+namespace openrisk::synthetic {
+
+/**
+ * @brief 单元测试与基准测试共用的合成数据
+ * 统一以 double 生成后再转换为 T，float / double 两组结果使用同一份数据，可以直接比对。
+ * 不依赖 GoogleTest / Google Benchmark，tests/test_common.hpp 与 bench/bench_common.hpp 都包含本文件。
+ */
+
+/**
+ * @brief 按 GARCH(1,1) (omega=2e-6, alpha=0.08, beta=0.9) 模拟收益率序列
+ */
+template <core::FloatingPoint T>
+Eigen::VectorX<T> garch_returns(std::size_t n, uint32_t seed = 42) {
+    core::RandomEngine<double> rng(seed);
+    Eigen::VectorXd z = rng.next_normal_vector(n);
+    Eigen::VectorXd r(n);
+    double sigma_sq = 1e-4;
+    for (std::size_t t = 0; t < n; ++t) {
+        r(t) = std::sqrt(sigma_sq) * z(t);
+        sigma_sq = 2e-6 + 0.08 * r(t) * r(t) + 0.9 * sigma_sq;
+    }
+    return r.cast<T>();
+}
+
+/**
+ * @brief T x N 收益率面板，含一个共同因子，资产间两两相关约 0.2
+ */
+template <core::FloatingPoint T>
+Eigen::MatrixX<T> return_panel(std::size_t t, std::size_t n, uint32_t seed = 42) {
+    core::RandomEngine<double> rng(seed);
+    Eigen::VectorXd market = rng.next_normal_vector(t);
+    Eigen::MatrixXd panel(t, n);
+    for (std::size_t j = 0; j < n; ++j) {
+        panel.col(j) = 0.01 * (0.45 * market + 0.9 * rng.next_normal_vector(t));
+    }
+    return panel.cast<T>();
+}
+
+template <core::FloatingPoint T>
+struct LPPLSeries {
+    Eigen::VectorX<T> t;
+    Eigen::VectorX<T> log_p;
+    T t_last;
+    crash::LPPLParams<double> truth; // 生成轨迹所用的参数
+};
+
+/**
+ * @brief 在临界点前 20 个时间单位结束的 LPPL 泡沫轨迹，叠加 1% 噪声
+ */
+template <core::FloatingPoint T>
+LPPLSeries<T> lppl_series(std::size_t n, uint32_t seed = 42) {
+    const crash::LPPLParams<double> truth{8.0, -0.5, 0.02, static_cast<double>(n) + 20.0, 0.4, 9.0, 1.0};
+    core::RandomEngine<double> rng(seed);
+    Eigen::VectorXd noise = rng.next_normal_vector(n);
+    Eigen::VectorXd t(n);
+    Eigen::VectorXd log_p(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        t(i) = static_cast<double>(i);
+        log_p(i) = crash::LPPLModel<double>::compute(t(i), truth) + 0.01 * noise(i);
+    }
+    return {t.cast<T>(), log_p.cast<T>(), static_cast<T>(n - 1), truth};
+}
+
+} // namespace openrisk::synthetic
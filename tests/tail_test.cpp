@@ -0,0 +1,57 @@
+#include "test_common.hpp"
+#include "openrisk/tail/var.hpp"
+#include <utility>
+
+namespace openrisk::test {
+namespace {
+
+using tail::RiskMetrics;
+
+TEST(RiskMetrics, HistoricalVarOnKnownSample) {
+    // 收益率 -1, -2, ..., -1000 / 1000：95% VaR 为第 floor(0.05 * 1000) = 50 小的收益率之后一个
+    const Eigen::VectorXd returns = -Eigen::VectorXd::LinSpaced(1'000, 1, 1'000) / 1'000.0;
+    EXPECT_DOUBLE_EQ(RiskMetrics<double>::historical_var(returns, 0.95), 0.950);
+    EXPECT_DOUBLE_EQ(RiskMetrics<double>::historical_var(returns, 0.99), 0.990);
+    // ES 为最差 50 个收益率的平均损失
+    EXPECT_NEAR(RiskMetrics<double>::expected_shortfall(returns, 0.95), (1.0 + 0.951) / 2, 1e-12);
+}
+
+TEST(RiskMetrics, FloatConfidenceLevelsCountExactly) {
+    // 0.95f、0.99f、0.999f 均无法精确表示，尾部样本个数仍须与十进制置信度一致
+    const std::pair<float, std::size_t> levels[] = {{0.95f, 50'000}, {0.975f, 25'000}, {0.99f, 10'000}, {0.999f, 1'000}};
+    for (const std::size_t n : {100u, 1'000u, 12'345u, 10'000'000u}) {
+        const Eigen::VectorXf returns = Eigen::VectorXf::LinSpaced(n, 0, static_cast<float>(n - 1));
+        Eigen::VectorXf scratch;
+        for (const auto& [c, tail_per_million] : levels) {
+            const auto expected = static_cast<float>(tail_per_million * n / 1'000'000);
+            EXPECT_EQ(-RiskMetrics<float>::historical_var(returns, c, scratch), expected) << "n=" << n << " c=" << c;
+        }
+    }
+}
+
+TEST(RiskMetrics, FloatMatchesDouble) {
+    const auto returns = garch_returns<double>(100'000);
+    for (const double c : {0.95, 0.975, 0.99}) {
+        EXPECT_TRUE(relatively_near(RiskMetrics<float>::historical_var(returns.cast<float>(), static_cast<float>(c)),
+                                    RiskMetrics<double>::historical_var(returns, c), 1e-6));
+        EXPECT_TRUE(relatively_near(RiskMetrics<float>::expected_shortfall(returns.cast<float>(), static_cast<float>(c)),
+                                    RiskMetrics<double>::expected_shortfall(returns, c), 1e-6));
+        EXPECT_TRUE(relatively_near(RiskMetrics<float>::parametric_var(returns.cast<float>(), static_cast<float>(c)),
+                                    RiskMetrics<double>::parametric_var(returns, c), 1e-5));
+    }
+}
+
+TEST(RiskMetrics, ScratchBufferIsReused) {
+    const auto returns = garch_returns<double>(10'000);
+    Eigen::VectorXd scratch(returns.size());
+    const double* data = scratch.data();
+    const double var = RiskMetrics<double>::historical_var(returns, 0.99, scratch);
+    const double es = RiskMetrics<double>::expected_shortfall(returns, 0.99, scratch);
+    EXPECT_EQ(scratch.data(), data);
+    EXPECT_DOUBLE_EQ(var, RiskMetrics<double>::historical_var(returns, 0.99));
+    EXPECT_DOUBLE_EQ(es, RiskMetrics<double>::expected_shortfall(returns, 0.99));
+    EXPECT_GE(es, var);
+}
+
+} // namespace
+} // namespace openrisk::test
@@ -0,0 +1,50 @@
+#pragma once
+#include "synthetic_data.hpp"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+
+namespace openrisk::test {
+
+using synthetic::garch_returns;
+using synthetic::lppl_series;
+using synthetic::LPPLSeries;
+using synthetic::return_panel;
+
+/**
+ * @brief |value - reference| <= tolerance * |reference|
+ */
+inline ::testing::AssertionResult relatively_near(double value, double reference, double tolerance) {
+    const double error = std::abs(value - reference) / std::max(std::abs(reference), 1e-300);
+    if (error <= tolerance) return ::testing::AssertionSuccess();
+    return ::testing::AssertionFailure() << value << " vs reference " << reference << ": relative error "
+                                         << error << " exceeds " << tolerance;
+}
+
+/**
+ * @brief 矩阵版本：||value - reference||_F <= tolerance * ||reference||_F
+ */
+template <core::FloatingPoint T>
+::testing::AssertionResult relatively_near(const Eigen::MatrixX<T>& value, const Eigen::MatrixXd& reference,
+                                           double tolerance) {
+    if (value.rows() != reference.rows() || value.cols() != reference.cols()) {
+        return ::testing::AssertionFailure() << "shape mismatch";
+    }
+    const double error = (value.template cast<double>() - reference).norm() / std::max(reference.norm(), 1e-300);
+    if (error <= tolerance) return ::testing::AssertionSuccess();
+    return ::testing::AssertionFailure() << "relative error " << error << " exceeds " << tolerance;
+}
+
+/**
+ * @brief 按优化引擎参数化的测试套件的用例名后缀
+ */
+inline std::string optimizer_name(const ::testing::TestParamInfo<core::OptimizerKind>& info) {
+    switch (info.param) {
+        case core::OptimizerKind::NelderMead: return "NelderMead";
+        case core::OptimizerKind::DifferentialEvolution: return "DifferentialEvolution";
+        case core::OptimizerKind::LBFGS: break;
+    }
+    return "LBFGS";
+}
+
+} // namespace openrisk::test
@@ -0,0 +1,60 @@
+#include "test_common.hpp"
+#include "openrisk/time_series/garch.hpp"
+#include <numbers>
+
+namespace openrisk::test {
+namespace {
+
+using time_series::GarchModel;
+using time_series::GarchParams;
+
+TEST(GarchModel, FilterFloatMatchesDouble) {
+    const auto returns = garch_returns<double>(10'000);
+    const GarchParams<double> params{2e-6, 0.08, 0.9};
+
+    const Eigen::VectorXd reference = GarchModel<double>::filter(returns, params);
+    const Eigen::VectorXf value = GarchModel<float>::filter(returns.cast<float>(), {2e-6f, 0.08f, 0.9f});
+    EXPECT_TRUE(relatively_near<float>(value, reference, 1e-5));
+}
+
+TEST(GarchModel, FilterChecksOutputLength) {
+    const auto returns = garch_returns<double>(100);
+    Eigen::VectorXd sigmas_sq(99);
+    EXPECT_THROW(GarchModel<double>::filter(returns, {2e-6, 0.08, 0.9}, sigmas_sq), std::invalid_argument);
+}
+
+TEST(GarchModel, LogLikelihoodFloatMatchesDouble) {
+    const auto returns = garch_returns<double>(100'000);
+    const double reference = GarchModel<double>::log_likelihood(returns, GarchParams<double>{2e-6, 0.08, 0.9});
+    const float value = GarchModel<float>::log_likelihood(returns.cast<float>(), GarchParams<float>{2e-6f, 0.08f, 0.9f});
+    EXPECT_TRUE(relatively_near(value, reference, 1e-6));
+}
+
+TEST(GarchModel, LogLikelihoodMatchesDirectSum) {
+    // 块状向量化求和与逐项求和一致
+    const auto returns = garch_returns<double>(1'000);
+    const GarchParams<double> params{2e-6, 0.08, 0.9};
+    const Eigen::VectorXd sigmas_sq = GarchModel<double>::filter(returns, params);
+    double log_lik = 0;
+    for (Eigen::Index t = 0; t < returns.size(); ++t) {
+        log_lik += -0.5 * (std::log(2 * std::numbers::pi) + std::log(sigmas_sq(t)) + returns(t) * returns(t) / sigmas_sq(t));
+    }
+    EXPECT_TRUE(relatively_near(GarchModel<double>::log_likelihood(returns, params), -log_lik, 1e-12));
+}
+
+TEST(GarchModel, PanelMatchesColumns) {
+    Eigen::MatrixXd panel(2'000, 3);
+    for (int j = 0; j < 3; ++j) panel.col(j) = garch_returns<double>(2'000, 7 + j);
+    const std::vector<GarchParams<double>> params{{2e-6, 0.08, 0.9}, {3e-6, 0.05, 0.92}, {1e-6, 0.1, 0.85}};
+
+    const Eigen::MatrixXd sigmas_sq = GarchModel<double>::filter_panel(panel, params);
+    const Eigen::VectorXd log_lik = GarchModel<double>::log_likelihood_panel(panel, params);
+    for (int j = 0; j < 3; ++j) {
+        EXPECT_TRUE(relatively_near<double>(sigmas_sq.col(j), GarchModel<double>::filter(panel.col(j), params[j]), 0));
+        EXPECT_DOUBLE_EQ(log_lik(j), GarchModel<double>::log_likelihood(panel.col(j), params[j]));
+    }
+    EXPECT_THROW(GarchModel<double>::log_likelihood_panel(panel, {params[0]}), std::invalid_argument);
+}
+
+} // namespace
+} // namespace openrisk::test